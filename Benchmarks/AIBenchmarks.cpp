@@ -0,0 +1,76 @@
+#include <chrono>
+#include <benchmark/benchmark.h>
+#include <SopraGameLogic/conversions.h>
+#include "BenchmarkMatch.h"
+
+namespace benchmarks {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * AI::getFeatureVec only forwards to the encoder of the AI, which is benchmarked directly
+     */
+    void aiGetFeatureVec(benchmark::State &state) {
+        Match match;
+        match.advanceTo([](const communication::messages::broadcast::Next &next){
+            return next.getTurnType() == communication::messages::types::TurnType::MOVE &&
+                !gameLogic::conversions::isBall(next.getEntityId());
+        });
+
+        ai::FeatureEncoder encoder{gameModel::TeamSide::LEFT};
+        auto gameState = match.game->getState();
+        for(auto _ : state){
+            benchmark::DoNotOptimize(encoder.encode(gameState));
+        }
+    }
+
+    void aiGetNextAction(benchmark::State &state, communication::messages::types::TurnType turnType) {
+        Match match;
+        auto isTurn = [turnType](const communication::messages::broadcast::Next &next){
+            return next.getTurnType() == turnType && !gameLogic::conversions::isBall(next.getEntityId());
+        };
+
+        for(auto _ : state){
+            if(!match.advanceTo(isTurn)){
+                state.SkipWithError("Turn type does not occur");
+                break;
+            }
+
+            auto &ai = match.actingAI();
+            auto start = Clock::now();
+            auto action = ai.getNextAction(match.next);
+            state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+            benchmark::DoNotOptimize(action);
+            match.step();
+        }
+    }
+
+    /**
+     * Times the update of the acting AI after its own player turn, which includes the training step
+     */
+    void aiUpdate(benchmark::State &state) {
+        Match match;
+        auto isPlayerTurn = [](const communication::messages::broadcast::Next &next){
+            return !gameLogic::conversions::isBall(next.getEntityId()) &&
+                next.getTurnType() != communication::messages::types::TurnType::FAN;
+        };
+
+        for(auto _ : state){
+            match.advanceTo(isPlayerTurn);
+            auto &ai = match.actingAI();
+            match.execute();
+            auto next = match.game->getNextAction();
+            auto gameState = match.game->getState();
+            auto start = Clock::now();
+            ai.update(gameState, std::nullopt, ai.getSide());
+            state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+            match.finishStep(next, &ai);
+        }
+    }
+
+    BENCHMARK(aiGetFeatureVec)->Name("AI::getFeatureVec");
+    BENCHMARK_CAPTURE(aiGetNextAction, move, communication::messages::types::TurnType::MOVE)->UseManualTime();
+    BENCHMARK_CAPTURE(aiGetNextAction, action, communication::messages::types::TurnType::ACTION)->UseManualTime();
+    BENCHMARK_CAPTURE(aiGetNextAction, fan, communication::messages::types::TurnType::FAN)->UseManualTime();
+    BENCHMARK_CAPTURE(aiGetNextAction, removeBan, communication::messages::types::TurnType::REMOVE_BAN)->UseManualTime();
+    BENCHMARK(aiUpdate)->Name("AI::update")->UseManualTime();
+}
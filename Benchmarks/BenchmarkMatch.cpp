@@ -0,0 +1,117 @@
+#include <fstream>
+#include <SopraGameLogic/conversions.h>
+#include <AI/NetFile.h>
+#include "BenchmarkMatch.h"
+
+namespace benchmarks {
+    template<typename T>
+    auto readJson(const std::string &fileName) -> T {
+        std::ifstream ifstream{std::string{KITRAINING_DATA_DIR} + "/" + fileName};
+        if(!ifstream.good()){
+            throw std::runtime_error("Could not open " + fileName);
+        }
+
+        nlohmann::json json;
+        ifstream >> json;
+        return json.get<T>();
+    }
+
+    auto loadMatchConfig() -> communication::messages::broadcast::MatchConfig {
+        return readJson<communication::messages::broadcast::MatchConfig>("matchConfig.json");
+    }
+
+    auto loadTeamConfig(gameModel::TeamSide side) -> communication::messages::request::TeamConfig {
+        return readJson<communication::messages::request::TeamConfig>(
+                side == gameModel::TeamSide::LEFT ? "leftTeamConfig.json" : "rightTeamConfig.json");
+    }
+
+    auto netPath(gameModel::TeamSide side) -> std::string {
+        return std::string{KITRAINING_DATA_DIR} + "/CurrentTrainingFiles/" +
+               (side == gameModel::TeamSide::LEFT ? "left.json" : "right.json");
+    }
+
+    auto loadNets() -> communication::Nets {
+        return std::make_pair(std::make_shared<ai::StateEstimator>(ai::loadNet(netPath(gameModel::TeamSide::LEFT))),
+                              std::make_shared<ai::StateEstimator>(ai::loadNet(netPath(gameModel::TeamSide::RIGHT))));
+    }
+
+    auto netsMatchLayout() -> bool {
+        for(auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}){
+            if(ai::featureLayoutOf(netPath(side)) != ai::FeatureEncoder::LAYOUT_VERSION){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    auto silentLog() -> util::Logging & {
+        static std::ostream nullStream{nullptr};
+        static util::Logging log{nullStream, 0};
+        return log;
+    }
+
+    Match::Match(std::uint64_t seed) : seed(seed), nets(loadNets()) {
+        start();
+    }
+
+    void Match::execute() {
+        lastSide.reset();
+        if(gameLogic::conversions::isBall(next.getEntityId())){
+            game->executeBallDelta(next.getEntityId());
+        } else {
+            auto [action, side] = playerAction();
+            game->executeDelta(action, side);
+            lastSide = side;
+        }
+    }
+
+    auto Match::playerAction() const -> std::pair<communication::messages::request::DeltaRequest, gameModel::TeamSide> {
+        auto action = ais->first.getNextAction(next);
+        if(action.has_value()){
+            return {*action, gameModel::TeamSide::LEFT};
+        }
+
+        action = ais->second.getNextAction(next);
+        if(!action.has_value()){
+            throw std::runtime_error{"No player wants to perform an action!"};
+        }
+
+        return {*action, gameModel::TeamSide::RIGHT};
+    }
+
+    void Match::finishStep(const communication::messages::broadcast::Next &nextTurn, const ai::AI *updated) {
+        next = nextTurn;
+        if(game->winEvent.has_value()){
+            seed++;
+            start();
+            return;
+        }
+
+        for(auto *ai : {&ais->first, &ais->second}){
+            if(ai != updated){
+                ai->update(game->getState(), std::nullopt, lastSide);
+            }
+        }
+    }
+
+    void Match::step() {
+        execute();
+        finishStep(game->getNextAction());
+    }
+
+    auto Match::actingAI() -> ai::AI & {
+        return gameLogic::conversions::idToSide(next.getEntityId()) == gameModel::TeamSide::LEFT ? ais->first : ais->second;
+    }
+
+    void Match::start() {
+        ais.reset();
+        game = std::make_unique<gameHandling::Game>(loadMatchConfig(), loadTeamConfig(gameModel::TeamSide::LEFT),
+                loadTeamConfig(gameModel::TeamSide::RIGHT), aiTools::getTeamFormation(gameModel::TeamSide::LEFT),
+                aiTools::getTeamFormation(gameModel::TeamSide::RIGHT), silentLog(), "---", seed);
+        ais.emplace(ai::AI{game->environment, gameModel::TeamSide::LEFT, nets.first, 0, DISCOUNT_RATE, silentLog()},
+                    ai::AI{game->environment, gameModel::TeamSide::RIGHT, nets.second, 0, DISCOUNT_RATE, silentLog()});
+        lastSide.reset();
+        next = game->getNextAction();
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef KITRAINING_BENCHMARKMATCH_H
+#define KITRAINING_BENCHMARKMATCH_H
+
+#include <memory>
+#include <optional>
+#include <SopraMessages/MatchConfig.hpp>
+#include <SopraMessages/TeamConfig.hpp>
+#include <SopraUtil/Logging.hpp>
+#include <Game/Game.h>
+#include <AI/AI.h>
+#include <Communication/Communicator.h>
+
+namespace benchmarks {
+    constexpr std::uint64_t SEED = 42;
+    constexpr auto DISCOUNT_RATE = 0.9;
+
+    /**
+     * @return the match config from matchConfig.json
+     */
+    auto loadMatchConfig() -> communication::messages::broadcast::MatchConfig;
+
+    /**
+     * @param side
+     * @return the team config from leftTeamConfig.json or rightTeamConfig.json
+     */
+    auto loadTeamConfig(gameModel::TeamSide side) -> communication::messages::request::TeamConfig;
+
+    /**
+     * Loads the networks from CurrentTrainingFiles, so every run rates with the same weights. Throws a
+     * std::runtime_error if they were trained with another feature layout than the current one.
+     * @return
+     */
+    auto loadNets() -> communication::Nets;
+
+    /**
+     * @return true if both networks in CurrentTrainingFiles were trained with the current feature layout
+     */
+    auto netsMatchLayout() -> bool;
+
+    /**
+     * @return logging instance discarding all output
+     */
+    auto silentLog() -> util::Logging &;
+
+    /**
+     * Game played by two AIs like in Communicator::run, split into single steps so that benchmarks can time parts of
+     * a step. The AIs do not learn (learning rate 0). The seed only fixes the draws of the game itself, the actions of
+     * the game logic draw from its own generator which can not be seeded, so the games differ between runs.
+     * Finished games are restarted with the next seed.
+     */
+    class Match {
+    public:
+        /**
+         * Constructor
+         * @param seed seed of the first game
+         */
+        explicit Match(std::uint64_t seed = SEED);
+
+        /**
+         * Executes the pending turn
+         */
+        void execute();
+
+        /**
+         * @return the action for the pending player turn and the side of the acting team
+         */
+        auto playerAction() const -> std::pair<communication::messages::request::DeltaRequest, gameModel::TeamSide>;
+
+        /**
+         * Completes a step after execute: sets the next turn, updates the AIs and restarts the game if it is finished
+         * @param nextTurn the result of game->getNextAction()
+         * @param updated an AI the caller already updated with the current state, it is not updated again
+         */
+        void finishStep(const communication::messages::broadcast::Next &nextTurn, const ai::AI *updated = nullptr);
+
+        /**
+         * Executes the pending turn and fetches the next one
+         */
+        void step();
+
+        /**
+         * Steps until the pending turn fulfills the predicate
+         * @param predicate
+         * @param maxSteps
+         * @return false if the predicate was not fulfilled within maxSteps steps
+         */
+        template<typename Predicate>
+        bool advanceTo(const Predicate &predicate, std::size_t maxSteps = 100000);
+
+        /**
+         * @return the AI of the team that has to act in the pending turn
+         */
+        auto actingAI() -> ai::AI &;
+
+        std::unique_ptr<gameHandling::Game> game;
+        std::optional<std::pair<ai::AI, ai::AI>> ais;
+        communication::messages::broadcast::Next next;
+
+    private:
+        std::uint64_t seed;
+        communication::Nets nets;
+        std::optional<gameModel::TeamSide> lastSide;
+
+        void start();
+    };
+
+    template<typename Predicate>
+    bool Match::advanceTo(const Predicate &predicate, std::size_t maxSteps) {
+        for(std::size_t i = 0; i < maxSteps; i++){
+            if(predicate(next)){
+                return true;
+            }
+
+            step();
+        }
+
+        return predicate(next);
+    }
+}
+
+#endif //KITRAINING_BENCHMARKMATCH_H
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <SopraGameLogic/conversions.h>
+#include "BenchmarkMatch.h"
+
+namespace benchmarks {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Steps further into the game between two sampled states, so that the timed calls see realistic states
+     */
+    constexpr auto STEPS_BETWEEN_STATES = 7;
+
+    /**
+     * Number of sampled states the timed calls cycle through
+     */
+    constexpr std::size_t STATE_COUNT = 256;
+
+    void gameGetState(benchmark::State &state) {
+        // The games are prepared before the timed loop, pausing the timer in every iteration costs more than getState
+        Match match;
+        std::vector<std::unique_ptr<gameHandling::Game>> games;
+        games.reserve(STATE_COUNT);
+        for(std::size_t i = 0; i < STATE_COUNT; i++){
+            for(auto step = 0; step < STEPS_BETWEEN_STATES; step++){
+                match.step();
+            }
+
+            games.emplace_back(std::make_unique<gameHandling::Game>(loadMatchConfig(), match.game->getState(),
+                                                                    silentLog(), "---", SEED + i));
+        }
+
+        std::size_t index = 0;
+        for(auto _ : state){
+            benchmark::DoNotOptimize(games[index]->getState());
+            index = (index + 1) % games.size();
+        }
+    }
+
+    void gameGetNextAction(benchmark::State &state) {
+        Match match;
+        for(auto _ : state){
+            match.execute();
+            auto start = Clock::now();
+            auto next = match.game->getNextAction();
+            state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+            match.finishStep(next);
+        }
+    }
+
+    void gameExecuteDelta(benchmark::State &state) {
+        Match match;
+        auto isPlayerTurn = [](const communication::messages::broadcast::Next &next){
+            return !gameLogic::conversions::isBall(next.getEntityId());
+        };
+
+        for(auto _ : state){
+            match.advanceTo(isPlayerTurn);
+            auto [action, side] = match.playerAction();
+            auto start = Clock::now();
+            match.game->executeDelta(action, side);
+            state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+            match.finishStep(match.game->getNextAction());
+        }
+    }
+
+    void gameExecuteBallDelta(benchmark::State &state) {
+        Match match;
+        auto isBallTurn = [](const communication::messages::broadcast::Next &next){
+            return gameLogic::conversions::isBall(next.getEntityId());
+        };
+
+        for(auto _ : state){
+            match.advanceTo(isBallTurn);
+            auto start = Clock::now();
+            match.game->executeBallDelta(match.next.getEntityId());
+            state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+            match.finishStep(match.game->getNextAction());
+        }
+    }
+
+    BENCHMARK(gameGetState)->Name("Game::getState");
+    BENCHMARK(gameGetNextAction)->Name("Game::getNextAction")->UseManualTime();
+    BENCHMARK(gameExecuteDelta)->Name("Game::executeDelta")->UseManualTime();
+    BENCHMARK(gameExecuteBallDelta)->Name("Game::executeBallDelta")->UseManualTime();
+}
@@ -0,0 +1,39 @@
+#include <limits>
+#include <benchmark/benchmark.h>
+#include "BenchmarkMatch.h"
+
+namespace benchmarks {
+    constexpr auto LEARNING_RATE = 0.0001;
+
+    auto sampleFeatures() -> ai::FeatureVec {
+        Match match;
+        match.advanceTo([](const communication::messages::broadcast::Next &next){
+            return next.getTurnType() == communication::messages::types::TurnType::MOVE;
+        });
+
+        return ai::FeatureEncoder{gameModel::TeamSide::LEFT}.encode(match.game->getState());
+    }
+
+    void mlpForward(benchmark::State &state) {
+        auto net = *loadNets().first;
+        auto features = sampleFeatures();
+        for(auto _ : state){
+            benchmark::DoNotOptimize(net.forward(features));
+        }
+    }
+
+    void mlpTrain(benchmark::State &state) {
+        auto net = *loadNets().first;
+        auto features = sampleFeatures();
+        auto errFun = [](const std::array<double, 1> &out, const std::array<double, 1> &){
+            return 0.1 - out[0];
+        };
+
+        for(auto _ : state){
+            benchmark::DoNotOptimize(net.train({features}, {{0}}, std::numeric_limits<double>::infinity(), errFun, LEARNING_RATE));
+        }
+    }
+
+    BENCHMARK(mlpForward)->Name("Mlp::forward");
+    BENCHMARK(mlpTrain)->Name("Mlp::train");
+}
@@ -0,0 +1,61 @@
+#include "ThroughputReport.h"
+
+namespace benchmarks {
+    auto ThroughputReport::gamesPerSecond() const -> double {
+        return epochs / seconds;
+    }
+
+    auto ThroughputReport::stepsPerSecond() const -> double {
+        return steps / seconds;
+    }
+
+    auto ThroughputReport::decisionsPerSecond() const -> double {
+        return decisions / seconds;
+    }
+
+    auto ThroughputReport::tdUpdatesPerSecond() const -> double {
+        return tdUpdates / seconds;
+    }
+
+    void to_json(nlohmann::json &j, const ThroughputReport &report) {
+        j["epochs"] = report.epochs;
+        j["seed"] = report.seed;
+        j["seconds"] = report.seconds;
+        j["steps"] = report.steps;
+        j["decisions"] = report.decisions;
+        j["tdUpdates"] = report.tdUpdates;
+        j["peakRssKiB"] = report.peakRssKiB;
+        j["gamesPerSecond"] = report.gamesPerSecond();
+        j["stepsPerSecond"] = report.stepsPerSecond();
+        j["decisionsPerSecond"] = report.decisionsPerSecond();
+        j["tdUpdatesPerSecond"] = report.tdUpdatesPerSecond();
+    }
+
+    void from_json(const nlohmann::json &j, ThroughputReport &report) {
+        report.epochs = j.at("epochs").get<std::size_t>();
+        report.seed = j.at("seed").get<std::uint64_t>();
+        report.seconds = j.at("seconds").get<double>();
+        report.steps = j.at("steps").get<std::size_t>();
+        report.decisions = j.at("decisions").get<std::size_t>();
+        report.tdUpdates = j.at("tdUpdates").get<std::size_t>();
+        report.peakRssKiB = j.at("peakRssKiB").get<long>();
+    }
+
+    auto compare(const ThroughputReport &baseline, const ThroughputReport &current, double threshold) ->
+        std::vector<MetricChange> {
+        std::vector<MetricChange> changes;
+        auto addRate = [&changes, threshold](const std::string &name, double baselineValue, double currentValue){
+            changes.emplace_back(MetricChange{name, baselineValue, currentValue,
+                                              currentValue < baselineValue * (1 - threshold)});
+        };
+
+        addRate("gamesPerSecond", baseline.gamesPerSecond(), current.gamesPerSecond());
+        addRate("stepsPerSecond", baseline.stepsPerSecond(), current.stepsPerSecond());
+        addRate("decisionsPerSecond", baseline.decisionsPerSecond(), current.decisionsPerSecond());
+        addRate("tdUpdatesPerSecond", baseline.tdUpdatesPerSecond(), current.tdUpdatesPerSecond());
+        changes.emplace_back(MetricChange{"peakRssKiB", static_cast<double>(baseline.peakRssKiB),
+                                          static_cast<double>(current.peakRssKiB),
+                                          current.peakRssKiB > baseline.peakRssKiB * (1 + threshold)});
+        return changes;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef KITRAINING_THROUGHPUTREPORT_H
+#define KITRAINING_THROUGHPUTREPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace benchmarks {
+    /**
+     * Result of one end-to-end training run
+     */
+    struct ThroughputReport {
+        std::size_t epochs = 0;
+        std::uint64_t seed = 0;
+        double seconds = 0;
+        std::size_t steps = 0;
+        std::size_t decisions = 0;
+        std::size_t tdUpdates = 0;
+        long peakRssKiB = 0;
+
+        auto gamesPerSecond() const -> double;
+        auto stepsPerSecond() const -> double;
+        auto decisionsPerSecond() const -> double;
+        auto tdUpdatesPerSecond() const -> double;
+    };
+
+    void to_json(nlohmann::json &j, const ThroughputReport &report);
+    void from_json(const nlohmann::json &j, ThroughputReport &report);
+
+    /**
+     * Relative change of one metric between two reports
+     */
+    struct MetricChange {
+        std::string name;
+        double baseline;
+        double current;
+        bool regression; ///< The metric got worse by more than the threshold
+    };
+
+    /**
+     * Compares the rates and the peak memory usage of two reports
+     * @param baseline
+     * @param current
+     * @param threshold allowed relative loss of throughput or increase of memory usage, e.g. 0.05
+     * @return all compared metrics
+     */
+    auto compare(const ThroughputReport &baseline, const ThroughputReport &current, double threshold) ->
+        std::vector<MetricChange>;
+}
+
+#endif //KITRAINING_THROUGHPUTREPORT_H
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sys/resource.h>
+#include <Communication/Communicator.h>
+#include <BenchmarkMatch.h>
+#include "ThroughputReport.h"
+
+constexpr auto LEARNING_RATE = 0.001;
+constexpr auto DEFAULT_THRESHOLD = 0.05;
+
+void printUsage() {
+    std::cerr << "Usage: KiTrainingThroughput run epochs report.json [seed]" << std::endl
+              << "       KiTrainingThroughput compare baseline.json current.json [threshold]" << std::endl;
+}
+
+auto peakRssKiB() -> long {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * Trains the nets from CurrentTrainingFiles for the given number of epochs with one game per epoch, like main does.
+ * The seed fixes the draws of the games, the game logic draws from a generator which can not be seeded, so two runs
+ * do not play the same games.
+ */
+auto runEpochs(std::size_t epochs, std::uint64_t seed) -> benchmarks::ThroughputReport {
+    auto matchConfig = benchmarks::loadMatchConfig();
+    auto leftTeamConfig = benchmarks::loadTeamConfig(gameModel::TeamSide::LEFT);
+    auto rightTeamConfig = benchmarks::loadTeamConfig(gameModel::TeamSide::RIGHT);
+    auto nets = benchmarks::loadNets();
+
+    benchmarks::ThroughputReport report;
+    report.epochs = epochs;
+    report.seed = seed;
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t epoch = 0; epoch < epochs; epoch++){
+        communication::Communicator communicator{matchConfig, leftTeamConfig, rightTeamConfig, benchmarks::silentLog(),
+                                                 LEARNING_RATE, benchmarks::DISCOUNT_RATE, nets, "---", seed + epoch};
+        auto statistics = communicator.getStatistics();
+        report.steps += statistics.steps;
+        report.decisions += statistics.decisions;
+        report.tdUpdates += statistics.tdUpdates();
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.peakRssKiB = peakRssKiB();
+    return report;
+}
+
+auto readReport(const std::string &fileName) -> benchmarks::ThroughputReport {
+    std::ifstream ifstream{fileName};
+    if(!ifstream.good()){
+        throw std::runtime_error("Could not open " + fileName);
+    }
+
+    nlohmann::json json;
+    ifstream >> json;
+    return json.get<benchmarks::ThroughputReport>();
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 4 || argc > 5){
+        printUsage();
+        return 1;
+    }
+
+    std::string mode{argv[1]};
+    if(mode == "run"){
+        std::uint64_t seed = argc == 5 ? std::stoull(argv[4]) : benchmarks::SEED;
+        auto report = runEpochs(std::stoul(argv[2]), seed);
+        nlohmann::json json = report;
+        std::ofstream{argv[3]} << json.dump(4) << std::endl;
+        std::cout << json.dump(4) << std::endl;
+        return 0;
+    } else if(mode == "compare"){
+        auto threshold = argc == 5 ? std::stod(argv[4]) : DEFAULT_THRESHOLD;
+        auto baseline = readReport(argv[2]);
+        auto current = readReport(argv[3]);
+        if(baseline.epochs != current.epochs || baseline.seed != current.seed){
+            std::cerr << "Warning: reports were created with different epochs or seeds" << std::endl;
+        }
+
+        bool regression = false;
+        for(const auto &change : benchmarks::compare(baseline, current, threshold)){
+            std::cout << change.name << ": " << change.baseline << " -> " << change.current << " ("
+                      << (change.current / change.baseline - 1) * 100 << "%)"
+                      << (change.regression ? " REGRESSION" : "") << std::endl;
+            regression |= change.regression;
+        }
+
+        return regression ? 2 : 0;
+    }
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,116 @@
+#ifndef KITRAINING_PERFBUDGETS_H
+#define KITRAINING_PERFBUDGETS_H
+
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <Throughput/ThroughputReport.h>
+
+namespace perf {
+    /**
+     * Reads a budget, budgets can be overridden per machine with environment variables of the given name
+     * @param name name of the environment variable
+     * @param defaultValue budget for the build box
+     * @return
+     */
+    inline auto budget(const char *name, double defaultValue) -> double {
+        auto value = std::getenv(name);
+        return value == nullptr ? defaultValue : std::stod(value);
+    }
+
+    /**
+     * Mean time of Game::getState in microseconds
+     */
+    inline auto maxGetStateUs() -> double {
+        return budget("KITRAINING_PERF_MAX_GET_STATE_US", 50);
+    }
+
+    /**
+     * Maximum slowdown of the games per second compared to the reference report
+     */
+    constexpr auto GAMES_PER_SECOND_TOLERANCE = 0.1;
+
+    /**
+     * Path of the reference report written by KiTrainingThroughput on the build box
+     */
+    inline auto referenceReportPath() -> std::string {
+        auto path = std::getenv("KITRAINING_PERF_REFERENCE");
+        return path == nullptr ? std::string{KITRAINING_DATA_DIR} + "/Tests/Perf/reference.json" : path;
+    }
+
+    /**
+     * Reads the reference report written by KiTrainingThroughput on the build box
+     * @return the report as json, nullopt if there is no reference
+     */
+    inline auto readReference() -> std::optional<nlohmann::json> {
+        std::ifstream file{referenceReportPath()};
+        if(!file.good()){
+            return std::nullopt;
+        }
+
+        nlohmann::json json;
+        file >> json;
+        return json;
+    }
+
+    /**
+     * Games per second when training on the reference configs with one game per epoch. Derived from the games per
+     * second measured by KiTrainingThroughput (which trains the same way) in the reference report.
+     * @return the budget, nullopt if neither the environment variable nor a reference report exists
+     */
+    inline auto minGamesPerSecond() -> std::optional<double> {
+        if(std::getenv("KITRAINING_PERF_MIN_GAMES_PER_SECOND") != nullptr){
+            return budget("KITRAINING_PERF_MIN_GAMES_PER_SECOND", 0);
+        }
+
+        auto reference = readReference();
+        if(!reference.has_value()){
+            return std::nullopt;
+        }
+
+        return reference->get<benchmarks::ThroughputReport>().gamesPerSecond() * (1 - GAMES_PER_SECOND_TOLERANCE);
+    }
+
+    /**
+     * Maximum increase of the allocations per step compared to the reference
+     */
+    constexpr auto ALLOCATIONS_TOLERANCE = 0.1;
+
+    /**
+     * Mean number of heap allocations of a step of a running game. A step allocates (getState clones the environment,
+     * the AITools search clones it per candidate), so the budget is derived from the allocationsPerStep measured by
+     * SteadyStateStepAllocationsWithinBudget and added to the reference report.
+     * @return the budget, nullopt if neither the environment variable nor a measured value exists
+     */
+    inline auto maxAllocationsPerStep() -> std::optional<double> {
+        if(std::getenv("KITRAINING_PERF_MAX_ALLOCATIONS_PER_STEP") != nullptr){
+            return budget("KITRAINING_PERF_MAX_ALLOCATIONS_PER_STEP", 0);
+        }
+
+        auto reference = readReference();
+        if(!reference.has_value() || reference->count("allocationsPerStep") == 0){
+            return std::nullopt;
+        }
+
+        return reference->at("allocationsPerStep").get<double>() * (1 + ALLOCATIONS_TOLERANCE);
+    }
+
+    /**
+     * Number of games played to measure the games per second, the length of the games varies a lot so the rate only
+     * settles over many games. The reference has to be recorded with the same number of epochs.
+     */
+    constexpr std::size_t THROUGHPUT_GAMES = 50;
+
+    /**
+     * Steps played before the allocations are counted, so that all buffers reached their final size
+     */
+    constexpr std::size_t ALLOCATION_WARM_UP_STEPS = 500;
+
+    /**
+     * Steps of which the allocations are counted
+     */
+    constexpr std::size_t ALLOCATION_STEPS = 1000;
+}
+
+#endif //KITRAINING_PERFBUDGETS_H
@@ -0,0 +1,158 @@
+#include <chrono>
+#include <gtest/gtest.h>
+#include <Profiling/AllocationTracker.h>
+#include <Profiling/Phase.h>
+#include <BenchmarkMatch.h>
+#include "PerfBudgets.h"
+
+// Google Test before 1.10 (e.g. the one of the Docker image) has no GTEST_SKIP, tests without a budget pass there
+#ifdef GTEST_SKIP
+#define KITRAINING_PERF_SKIP() GTEST_SKIP()
+#else
+#define KITRAINING_PERF_SKIP() return GTEST_SUCCEED()
+#endif
+
+// The games are only representative with networks trained for the current feature layout
+#define KITRAINING_PERF_REQUIRE_NETS() \
+    do { \
+        if(!benchmarks::netsMatchLayout()) { \
+            KITRAINING_PERF_SKIP() << "The networks in CurrentTrainingFiles were trained with another feature layout, " \
+                                   << "replace them by checkpoints of the current KiTraining"; \
+        } \
+    } while(false)
+
+namespace perf {
+    using Clock = std::chrono::steady_clock;
+    static_assert(profiling::allocationTrackingEnabled(), "PerfTests are built with KITRAINING_ALLOCATION_TRACKING");
+
+    TEST(Perf, GetStateWithinBudget) {
+        KITRAINING_PERF_REQUIRE_NETS();
+        benchmarks::Match match;
+        constexpr auto samples = 2000;
+        Clock::duration total{0};
+        for(auto i = 0; i < samples; i++){
+            match.step();
+            auto start = Clock::now();
+            auto state = match.game->getState();
+            total += Clock::now() - start;
+            EXPECT_TRUE(state.env);
+        }
+
+        auto meanUs = std::chrono::duration<double, std::micro>(total).count() / samples;
+        RecordProperty("meanGetStateUs", std::to_string(meanUs));
+        EXPECT_LE(meanUs, maxGetStateUs());
+    }
+
+    TEST(Perf, GamesPerSecondWithinBudget) {
+        KITRAINING_PERF_REQUIRE_NETS();
+        auto minimum = minGamesPerSecond();
+        if(!minimum.has_value()){
+            KITRAINING_PERF_SKIP() << "No reference at " << referenceReportPath() << ", record one on this machine with "
+                                   << "KiTrainingThroughput run " << THROUGHPUT_GAMES << " " << referenceReportPath();
+        }
+
+        auto matchConfig = benchmarks::loadMatchConfig();
+        auto leftTeamConfig = benchmarks::loadTeamConfig(gameModel::TeamSide::LEFT);
+        auto rightTeamConfig = benchmarks::loadTeamConfig(gameModel::TeamSide::RIGHT);
+        auto nets = benchmarks::loadNets();
+        auto start = Clock::now();
+        for(std::size_t game = 0; game < THROUGHPUT_GAMES; game++){
+            communication::Communicator communicator{matchConfig, leftTeamConfig, rightTeamConfig, benchmarks::silentLog(),
+                                                     0.001, benchmarks::DISCOUNT_RATE, nets, "---", benchmarks::SEED + game};
+            EXPECT_TRUE(communicator.getStatistics().result.has_value());
+        }
+
+        auto gamesPerSecond = THROUGHPUT_GAMES / std::chrono::duration<double>(Clock::now() - start).count();
+        RecordProperty("gamesPerSecond", std::to_string(gamesPerSecond));
+        EXPECT_GE(gamesPerSecond, *minimum);
+    }
+
+    /**
+     * A step of a running game (ball turn or decision, its execution and the updates of both AIs) must not allocate
+     * more than the baseline measured on the build box once the game and its buffers are warmed up
+     */
+    TEST(Perf, SteadyStateStepAllocationsWithinBudget) {
+        KITRAINING_PERF_REQUIRE_NETS();
+        benchmarks::Match match;
+        for(std::size_t i = 0; i < ALLOCATION_WARM_UP_STEPS; i++){
+            match.step();
+        }
+
+        profiling::AllocationReport total;
+        std::size_t measured = 0;
+        for(std::size_t i = 0; i < ALLOCATION_STEPS; i++){
+            profiling::resetAllocations();
+            match.execute();
+            auto nextTurn = match.game->getNextAction();
+            auto finished = match.game->winEvent.has_value();
+            match.finishStep(nextTurn);
+            auto report = profiling::collectAllocations();
+            // The last step of a game starts the next game, which allocates a new game and new AIs
+            if(finished){
+                continue;
+            }
+
+            measured++;
+            for(std::size_t region = 0; region < profiling::REGION_COUNT; region++){
+                total.regions[region].allocations += report.regions[region].allocations;
+                total.regions[region].bytes += report.regions[region].bytes;
+                total.regions[region].deallocations += report.regions[region].deallocations;
+            }
+        }
+
+        ASSERT_GT(measured, 0U);
+        std::uint64_t allocations = 0;
+        for(const auto &region : total.regions){
+            allocations += region.allocations;
+        }
+
+        auto allocationsPerStep = static_cast<double>(allocations) / measured;
+        RecordProperty("allocationsPerStep", std::to_string(allocationsPerStep));
+        auto maximum = maxAllocationsPerStep();
+        if(!maximum.has_value()){
+            KITRAINING_PERF_SKIP() << "No baseline, add \"allocationsPerStep\": " << allocationsPerStep << " to "
+                                   << referenceReportPath();
+        }
+
+        EXPECT_LE(allocationsPerStep, *maximum) << "Allocations of " << measured << " steps:\n"
+                                                << profiling::toString(total);
+    }
+
+    /**
+     * Rating a candidate (diff, patch and cache lookup) runs for every candidate of every decision and has to be
+     * allocation free once the buffers exist
+     */
+    TEST(Perf, CandidateRatingDoesNotAllocate) {
+        KITRAINING_PERF_REQUIRE_NETS();
+        benchmarks::Match match;
+        match.advanceTo([](const communication::messages::broadcast::Next &next){
+            return next.getTurnType() == communication::messages::types::TurnType::MOVE;
+        });
+
+        auto base = match.game->getState();
+        match.step();
+        auto candidate = match.game->getState();
+        ai::FeatureEncoder encoder{gameModel::TeamSide::LEFT};
+        ai::ValueCache cache{1024};
+        auto baseFeatures = encoder.encode(base);
+        ai::DiffBase diffBase{base};
+        auto features = baseFeatures;
+
+        profiling::resetAllocations();
+        for(auto i = 0; i < 100; i++){
+            features = baseFeatures;
+            encoder.patch(features, candidate, ai::FeatureEncoder::diff(diffBase, candidate));
+            if(!cache.lookup(features).has_value()){
+                cache.insert(features, 0);
+            }
+        }
+
+        auto report = profiling::collectAllocations();
+        std::uint64_t allocations = 0;
+        for(const auto &region : report.regions){
+            allocations += region.allocations;
+        }
+
+        EXPECT_EQ(allocations, 0U);
+    }
+}
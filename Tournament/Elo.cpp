@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <Game/Rng.h>
+#include "Elo.h"
+
+namespace tournament {
+    constexpr auto MAX_ITERATIONS = 10000;
+    constexpr auto TOLERANCE = 1e-9;
+
+    auto estimateElo(std::size_t players, const std::vector<Outcome> &outcomes) -> std::vector<double> {
+        std::vector<double> wins(players, 0);
+        std::vector<std::vector<double>> games(players, std::vector<double>(players, 0));
+        for(const auto &outcome : outcomes){
+            wins[outcome.winner]++;
+            games[outcome.winner][outcome.loser]++;
+            games[outcome.loser][outcome.winner]++;
+        }
+
+        for(std::size_t i = 0; i < players; i++){
+            for(std::size_t j = 0; j < players; j++){
+                if(i != j && games[i][j] > 0){
+                    wins[i] += 0.5;
+                    games[i][j]++;
+                }
+            }
+        }
+
+        // Minorization-maximization of the Bradley-Terry likelihood, strength = 10^(elo / 400)
+        std::vector<double> strength(players, 1);
+        for(int iteration = 0; iteration < MAX_ITERATIONS; iteration++){
+            std::vector<double> next(players, 1);
+            double logSum = 0;
+            for(std::size_t i = 0; i < players; i++){
+                double denominator = 0;
+                for(std::size_t j = 0; j < players; j++){
+                    if(i != j && games[i][j] > 0){
+                        denominator += games[i][j] / (strength[i] + strength[j]);
+                    }
+                }
+
+                if(denominator > 0){
+                    next[i] = wins[i] / denominator;
+                }
+
+                logSum += std::log(next[i]);
+            }
+
+            double change = 0;
+            auto scale = std::exp(-logSum / players);
+            for(std::size_t i = 0; i < players; i++){
+                next[i] *= scale;
+                change = std::max(change, std::abs(next[i] - strength[i]) / strength[i]);
+            }
+
+            strength = std::move(next);
+            if(change < TOLERANCE){
+                break;
+            }
+        }
+
+        std::vector<double> elo(players);
+        std::transform(strength.begin(), strength.end(), elo.begin(), [](double s){ return 400 * std::log10(s); });
+        return elo;
+    }
+
+    auto rate(std::size_t players, const std::vector<Outcome> &outcomes, std::size_t samples, double confidence,
+            std::uint64_t seed) -> std::vector<Rating> {
+        auto elo = estimateElo(players, outcomes);
+        std::vector<Rating> ratings(players);
+        for(std::size_t i = 0; i < players; i++){
+            ratings[i] = {elo[i], elo[i], elo[i]};
+        }
+
+        if(samples == 0 || outcomes.empty()){
+            return ratings;
+        }
+
+        gameHandling::Rng rng{seed};
+        std::vector<std::vector<double>> sampledElo(players, std::vector<double>(samples));
+        std::vector<Outcome> resampled(outcomes.size());
+        for(std::size_t sample = 0; sample < samples; sample++){
+            for(auto &outcome : resampled){
+                outcome = outcomes[rng(0, static_cast<int>(outcomes.size()) - 1)];
+            }
+
+            auto sampleElo = estimateElo(players, resampled);
+            for(std::size_t i = 0; i < players; i++){
+                sampledElo[i][sample] = sampleElo[i];
+            }
+        }
+
+        auto tail = (1 - confidence) / 2;
+        auto lowerIndex = static_cast<std::size_t>(tail * (samples - 1));
+        auto upperIndex = static_cast<std::size_t>(std::ceil((1 - tail) * (samples - 1)));
+        for(std::size_t i = 0; i < players; i++){
+            std::sort(sampledElo[i].begin(), sampledElo[i].end());
+            ratings[i].lower = sampledElo[i][lowerIndex];
+            ratings[i].upper = sampledElo[i][upperIndex];
+        }
+
+        return ratings;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef KITRAINING_ELO_H
+#define KITRAINING_ELO_H
+
+#include <cstdint>
+#include <vector>
+
+namespace tournament {
+    /**
+     * Result of one game between two players
+     */
+    struct Outcome {
+        std::size_t winner;
+        std::size_t loser;
+    };
+
+    /**
+     * Elo rating of a player with a confidence interval
+     */
+    struct Rating {
+        double elo;
+        double lower; ///< Lower bound of the confidence interval
+        double upper; ///< Upper bound of the confidence interval
+    };
+
+    /**
+     * Computes the maximum likelihood Elo ratings (Bradley-Terry model) of all players, the mean rating is 0. Every
+     * pair of players that met is treated as if it had played one additional draw, so ratings stay finite if a
+     * player won or lost all games.
+     * @param players number of players
+     * @param outcomes
+     * @return the rating of every player
+     */
+    auto estimateElo(std::size_t players, const std::vector<Outcome> &outcomes) -> std::vector<double>;
+
+    /**
+     * Computes the Elo ratings and their confidence intervals by bootstrapping: the games are resampled with
+     * replacement and the intervals are the percentiles of the ratings of all samples
+     * @param players number of players
+     * @param outcomes
+     * @param samples number of bootstrap samples
+     * @param confidence e.g. 0.95
+     * @param seed seed of the resampling
+     * @return the rating of every player
+     */
+    auto rate(std::size_t players, const std::vector<Outcome> &outcomes, std::size_t samples, double confidence,
+            std::uint64_t seed) -> std::vector<Rating>;
+}
+
+#endif //KITRAINING_ELO_H
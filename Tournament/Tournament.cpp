@@ -0,0 +1,147 @@
+#include <filesystem>
+#include <SopraAITools/AITools.h>
+#include <AI/NetFile.h>
+#include <AI/AI.h>
+#include <Communication/Communicator.h>
+#include "Tournament.h"
+
+namespace tournament {
+    auto loadCheckpoint(const std::string &fileName) -> Checkpoint {
+        if(!std::filesystem::exists(fileName)){
+            throw std::runtime_error("Checkpoint " + fileName + " does not exist");
+        }
+
+        auto name = std::filesystem::path{fileName}.stem().string();
+        auto homeSide = name.rfind("right", 0) == 0 ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
+        return {name, std::make_shared<const ai::StateEstimator>(
+                ai::loadNet(fileName)), homeSide};
+    }
+
+    auto GameResult::winner() const -> std::size_t {
+        return winningSide == gameModel::TeamSide::LEFT ? left : right;
+    }
+
+    auto GameResult::loser() const -> std::size_t {
+        return winningSide == gameModel::TeamSide::LEFT ? right : left;
+    }
+
+    auto Standing::winRate() const -> double {
+        return games == 0 ? 0 : static_cast<double>(wins) / games;
+    }
+
+    void to_json(nlohmann::json &j, const Report &report) {
+        j["confidence"] = report.confidence;
+        j["standings"] = nlohmann::json::array();
+        for(const auto &standing : report.standings){
+            nlohmann::json entry;
+            entry["name"] = standing.name;
+            entry["games"] = standing.games;
+            entry["wins"] = standing.wins;
+            entry["winRate"] = standing.winRate();
+            entry["winReasons"] = standing.winReasons;
+            entry["lossReasons"] = standing.lossReasons;
+            entry["elo"] = standing.rating.elo;
+            entry["eloLower"] = standing.rating.lower;
+            entry["eloUpper"] = standing.rating.upper;
+            j["standings"].push_back(entry);
+        }
+
+        j["wins"] = report.wins;
+    }
+
+    Tournament::Tournament(communication::messages::broadcast::MatchConfig matchConfig,
+                           communication::messages::request::TeamConfig leftTeamConfig,
+                           communication::messages::request::TeamConfig rightTeamConfig,
+                           std::vector<Checkpoint> checkpoints, Format format, std::size_t gamesPerPairing,
+                           std::uint64_t seed, bool makeUnmake) : matchConfig(std::move(matchConfig)),
+                           leftTeamConfig(std::move(leftTeamConfig)), rightTeamConfig(std::move(rightTeamConfig)),
+                           checkpoints(std::move(checkpoints)), makeUnmake(makeUnmake) {
+        if(this->checkpoints.size() < 2){
+            throw std::runtime_error("A tournament needs at least two checkpoints");
+        }
+
+        auto gamesPerSide = (gamesPerPairing + 1) / 2;
+        for(std::size_t i = 0; i < this->checkpoints.size(); i++){
+            for(std::size_t j = i + 1; j < this->checkpoints.size(); j++){
+                if(format == Format::Gauntlet && i != 0){
+                    break;
+                }
+
+                for(std::size_t game = 0; game < gamesPerSide; game++){
+                    schedule.emplace_back(GameResult{i, j, seed + schedule.size()});
+                    schedule.emplace_back(GameResult{j, i, seed + schedule.size()});
+                }
+            }
+        }
+    }
+
+    auto Tournament::run(std::size_t threads) const -> std::vector<GameResult> {
+        std::vector<GameResult> results(schedule.size());
+        auto pool = std::make_shared<ai::ThreadPool>(threads);
+        pool->run(schedule.size(), [this, &results, &pool](std::size_t task, std::size_t){
+            results[task] = play(schedule[task], pool);
+        });
+
+        return results;
+    }
+
+    auto Tournament::report(const std::vector<GameResult> &results, std::size_t bootstrapSamples,
+                            double confidence) const -> Report {
+        Report report;
+        report.confidence = confidence;
+        report.wins.assign(checkpoints.size(), std::vector<std::size_t>(checkpoints.size(), 0));
+        for(const auto &checkpoint : checkpoints){
+            auto &standing = report.standings.emplace_back();
+            standing.name = checkpoint.name;
+        }
+
+        std::vector<Outcome> outcomes;
+        outcomes.reserve(results.size());
+        for(const auto &result : results){
+            auto reason = communication::messages::types::toString(result.reason);
+            auto &winner = report.standings[result.winner()];
+            auto &loser = report.standings[result.loser()];
+            winner.games++;
+            winner.wins++;
+            winner.winReasons[reason]++;
+            loser.games++;
+            loser.lossReasons[reason]++;
+            report.wins[result.winner()][result.loser()]++;
+            outcomes.emplace_back(Outcome{result.winner(), result.loser()});
+        }
+
+        auto ratings = rate(checkpoints.size(), outcomes, bootstrapSamples, confidence,
+                results.empty() ? 0 : results.front().seed);
+        for(std::size_t i = 0; i < checkpoints.size(); i++){
+            report.standings[i].rating = ratings[i];
+        }
+
+        return report;
+    }
+
+    auto Tournament::play(GameResult game, const std::shared_ptr<ai::ThreadPool> &pool) const -> GameResult {
+        std::ostream nullStream{nullptr};
+        util::Logging log{nullStream, 0};
+        gameHandling::Game match{matchConfig, leftTeamConfig, rightTeamConfig,
+                                 aiTools::getTeamFormation(gameModel::TeamSide::LEFT),
+                                 aiTools::getTeamFormation(gameModel::TeamSide::RIGHT), log, "---", game.seed};
+
+        // AIs searching with AITools run on the worker of their game and use a value cache, MakeUnmakeSearch rates on the
+        // pool without one
+        ai::SearchOptions searchOptions{makeUnmake, 1, makeUnmake ? pool : nullptr,
+                                        makeUnmake ? 0 : ai::SearchOptions::GAME_CACHE_CAPACITY};
+        const auto &left = checkpoints[game.left];
+        const auto &right = checkpoints[game.right];
+        std::pair<ai::AI, ai::AI> ais{
+                ai::AI{match.environment, gameModel::TeamSide::LEFT, left.net, log, searchOptions,
+                       left.homeSide != gameModel::TeamSide::LEFT},
+                ai::AI{match.environment, gameModel::TeamSide::RIGHT, right.net, log, searchOptions,
+                       right.homeSide != gameModel::TeamSide::RIGHT}};
+
+        // The AIs do not train, update only tracks the state
+        communication::playGame(match, ais, log);
+        game.winningSide = match.winEvent->first;
+        game.reason = match.winEvent->second;
+        return game;
+    }
+}
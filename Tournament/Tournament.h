@@ -0,0 +1,135 @@
+#ifndef KITRAINING_TOURNAMENT_H
+#define KITRAINING_TOURNAMENT_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <SopraMessages/MatchConfig.hpp>
+#include <SopraMessages/TeamConfig.hpp>
+#include <AI/StateEstimator.h>
+#include <AI/ThreadPool.h>
+#include "Elo.h"
+
+namespace tournament {
+    /**
+     * A saved network taking part in the tournament
+     */
+    struct Checkpoint {
+        std::string name;
+        std::shared_ptr<const ai::StateEstimator> net;
+        gameModel::TeamSide homeSide; ///< The side the network was trained for, on the other side it plays mirrored
+    };
+
+    /**
+     * Loads a checkpoint. Networks from right_*.json files were trained for the right team, all others (left_*.json,
+     * shared_*.json) for the left team.
+     * @param fileName
+     * @return
+     */
+    auto loadCheckpoint(const std::string &fileName) -> Checkpoint;
+
+    enum class Format {
+        RoundRobin, ///< Every checkpoint plays every other checkpoint
+        Gauntlet ///< The first checkpoint plays every other checkpoint
+    };
+
+    /**
+     * Result of one tournament game
+     */
+    struct GameResult {
+        std::size_t left; ///< Index of the checkpoint playing the left team
+        std::size_t right; ///< Index of the checkpoint playing the right team
+        std::uint64_t seed;
+        gameModel::TeamSide winningSide{};
+        communication::messages::types::VictoryReason reason{};
+
+        auto winner() const -> std::size_t;
+        auto loser() const -> std::size_t;
+    };
+
+    /**
+     * Results of one checkpoint
+     */
+    struct Standing {
+        std::string name;
+        std::size_t games = 0;
+        std::size_t wins = 0;
+        std::map<std::string, std::size_t> winReasons; ///< Number of wins per VictoryReason
+        std::map<std::string, std::size_t> lossReasons; ///< Number of losses per VictoryReason
+        Rating rating{};
+
+        auto winRate() const -> double;
+    };
+
+    /**
+     * Summary of a tournament
+     */
+    struct Report {
+        std::vector<Standing> standings; ///< In the order of the checkpoints
+        std::vector<std::vector<std::size_t>> wins; ///< wins[i][j]: wins of checkpoint i against checkpoint j
+        double confidence;
+    };
+
+    void to_json(nlohmann::json &j, const Report &report);
+
+    /**
+     * Plays seeded games between checkpoints without training. Each pairing plays the same number of games with
+     * both checkpoints on both sides, the games are distributed over all threads.
+     */
+    class Tournament {
+    public:
+        /**
+         * Constructor
+         * @param matchConfig
+         * @param leftTeamConfig
+         * @param rightTeamConfig
+         * @param checkpoints
+         * @param format
+         * @param gamesPerPairing rounded up to an even number, so that every checkpoint plays both sides equally often
+         * @param seed seed of the first game, game i uses seed + i
+         * @param makeUnmake search with MakeUnmakeSearch instead of the AITools search functions used for training
+         */
+        Tournament(communication::messages::broadcast::MatchConfig matchConfig,
+                   communication::messages::request::TeamConfig leftTeamConfig,
+                   communication::messages::request::TeamConfig rightTeamConfig,
+                   std::vector<Checkpoint> checkpoints, Format format, std::size_t gamesPerPairing, std::uint64_t seed,
+                   bool makeUnmake = false);
+
+        /**
+         * Plays all games on a work-stealing pool. With MakeUnmakeSearch workers without a game of their own help rating
+         * the candidates of the remaining games.
+         * @param threads number of workers
+         * @return the results in the order of the schedule, independent of the number of threads
+         */
+        auto run(std::size_t threads) const -> std::vector<GameResult>;
+
+        /**
+         * Summarizes the results of run
+         * @param results
+         * @param bootstrapSamples number of samples for the confidence intervals of the Elo ratings
+         * @param confidence
+         * @return
+         */
+        auto report(const std::vector<GameResult> &results, std::size_t bootstrapSamples, double confidence) const -> Report;
+
+    private:
+        communication::messages::broadcast::MatchConfig matchConfig;
+        communication::messages::request::TeamConfig leftTeamConfig;
+        communication::messages::request::TeamConfig rightTeamConfig;
+        std::vector<Checkpoint> checkpoints;
+        std::vector<GameResult> schedule; ///< All games, results not set yet
+        bool makeUnmake;
+
+        /**
+         * Plays one game
+         * @param game the scheduled game
+         * @param pool rates the candidates of the AIs if they use MakeUnmakeSearch
+         * @return the game with its result
+         */
+        auto play(GameResult game, const std::shared_ptr<ai::ThreadPool> &pool) const -> GameResult;
+    };
+}
+
+#endif //KITRAINING_TOURNAMENT_H
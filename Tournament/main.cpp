@@ -0,0 +1,100 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <Util/Options.h>
+#include "Tournament.h"
+
+constexpr std::uint64_t DEFAULT_SEED = 42;
+constexpr std::size_t BOOTSTRAP_SAMPLES = 1000;
+constexpr auto CONFIDENCE = 0.95;
+
+void printUsage() {
+    std::cerr << "Usage: KiTrainingTournament matchConfig.json leftTeamConfig.json rightTeamConfig.json "
+                 "<round-robin|gauntlet> gamesPerPairing checkpoint.json checkpoint.json [checkpoint.json...] "
+                 "[--seed=<seed>] [--threads=<threadCount>] [--search=<aitools|make-unmake>] [--report=<report.json>]" << std::endl;
+}
+
+template <typename T>
+auto readJson(const std::string &fileName) -> T {
+    std::ifstream ifstream{fileName};
+    if(!ifstream.good()){
+        throw std::runtime_error("Could not open " + fileName);
+    }
+
+    nlohmann::json json;
+    ifstream >> json;
+    return json.get<T>();
+}
+
+void printReport(const tournament::Report &report) {
+    std::cout << std::left << std::setw(24) << "checkpoint" << std::right << std::setw(8) << "games"
+              << std::setw(8) << "wins" << std::setw(10) << "win rate" << std::setw(10) << "elo"
+              << std::setw(22) << std::to_string(static_cast<int>(report.confidence * 100)) + "% interval" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for(const auto &standing : report.standings){
+        std::cout << std::left << std::setw(24) << standing.name << std::right << std::setw(8) << standing.games
+                  << std::setw(8) << standing.wins << std::setw(9) << standing.winRate() * 100 << "%"
+                  << std::setw(10) << standing.rating.elo << std::setw(12) << "[" << standing.rating.lower << ", "
+                  << standing.rating.upper << "]" << std::endl;
+    }
+
+    for(const auto &standing : report.standings){
+        std::cout << std::endl << standing.name << ":" << std::endl;
+        for(const auto &[reason, count] : standing.winReasons){
+            std::cout << "  won by " << reason << ": " << count << std::endl;
+        }
+
+        for(const auto &[reason, count] : standing.lossReasons){
+            std::cout << "  lost by " << reason << ": " << count << std::endl;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    auto options = cli::extractOptions(argc, argv, {"seed", "threads", "search", "report"}, printUsage);
+    if(argc < 8){
+        printUsage();
+        return 1;
+    }
+
+    std::string mode{argv[4]};
+    auto search = options.count("search") ? options.at("search") : "aitools";
+    if((mode != "round-robin" && mode != "gauntlet") || (search != "aitools" && search != "make-unmake")){
+        printUsage();
+        return 1;
+    }
+
+    try {
+        std::vector<tournament::Checkpoint> checkpoints;
+        for(int i = 6; i < argc; i++){
+            checkpoints.emplace_back(tournament::loadCheckpoint(argv[i]));
+        }
+
+        auto seed = cli::numberOption(options, "seed", DEFAULT_SEED, printUsage);
+        auto threads = cli::numberOption<std::size_t>(options, "threads",
+                std::max(1U, std::thread::hardware_concurrency()), printUsage);
+        if(threads == 0){
+            cli::invalidValue("--threads", options.at("threads"), printUsage);
+        }
+
+        tournament::Tournament tournament{
+                readJson<communication::messages::broadcast::MatchConfig>(argv[1]),
+                readJson<communication::messages::request::TeamConfig>(argv[2]),
+                readJson<communication::messages::request::TeamConfig>(argv[3]), std::move(checkpoints),
+                mode == "gauntlet" ? tournament::Format::Gauntlet : tournament::Format::RoundRobin,
+                cli::parseNumber<std::size_t>("gamesPerPairing", argv[5], printUsage), seed, search == "make-unmake"};
+
+        auto report = tournament.report(tournament.run(threads), BOOTSTRAP_SAMPLES, CONFIDENCE);
+        printReport(report);
+        if(options.count("report")){
+            nlohmann::json json = report;
+            std::ofstream{options.at("report")} << json.dump(4) << std::endl;
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
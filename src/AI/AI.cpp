@@ -3,20 +3,45 @@
 //
 
 #include <SopraGameLogic/conversions.h>
+#include <Game/GameTypes.h>
+#include <Profiling/PhaseTimer.h>
+#include <Profiling/Tracer.h>
+#include <cmath>
 #include "AI.h"
 namespace ai{
     constexpr auto winReward = 1;
     constexpr auto goalReward = 0.2;
     constexpr auto possibleDisqReward = 0.5;
     constexpr auto possibleWinReward = 0.5;
-    AI::AI(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide mySide, double learningRate,
-           double discountRate, util::Logging log) : stateEstimator(ml::functions::relu, ml::functions::relu, ml::functions::identity),
+    AI::AI(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide mySide,
+           std::shared_ptr<StateEstimator> stateEstimator, double learningRate, double discountRate, util::Logging log,
+           SearchOptions searchOptions, TrainingOptions trainingOptions, std::shared_ptr<TargetNetwork> targetNetwork) :
+           stateEstimator(std::move(stateEstimator)), evaluator(this->stateEstimator),
            currentState{env, 1, communication::messages::types::PhaseType::BALL_PHASE, gameController::ExcessLength::None,
-                     0, false, {}, {}, {}, {}}, mySide(mySide),
-                                                     learningRate(learningRate), discountRate(discountRate), log(log) {}
+                        0, false, {}, {}, {}, {}},
+           mySide(mySide), encoder(mySide, trainingOptions.sharedNetwork && mySide == gameModel::TeamSide::RIGHT),
+           searchOptions(searchOptions), pool(searchPool(searchOptions)),
+           valueCache(std::make_shared<ValueCache>(pool ? 0 : searchOptions.cacheCapacity)),
+           learningRate(learningRate), discountRate(discountRate), trainingOptions(trainingOptions),
+           targetNetwork(std::move(targetNetwork)), log(log) {}
+
+    AI::AI(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide mySide,
+           std::shared_ptr<const StateEstimator> frozenEstimator, util::Logging log, SearchOptions searchOptions,
+           bool mirrored) :
+           AI(env, mySide, nullptr, 0, 0, std::move(log), searchOptions) {
+        evaluator = std::move(frozenEstimator);
+        encoder = FeatureEncoder{mySide, mirrored};
+    }
 
     void AI::update(const aiTools::State &state, const std::optional<gameModel::TeamSide> &winningSide,
             const std::optional<gameModel::TeamSide> &side) {
+        if(!isLearning()){
+            this->currentState = state;
+            return;
+        }
+
+        KITRAINING_PROFILE_PHASE(profiling::Phase::TdUpdate);
+        KITRAINING_TRACE_SCOPE("AI::update");
         double reward = 0;
         auto opponentSide = mySide == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
         if(winningSide.has_value()){
@@ -38,15 +63,9 @@ namespace ai{
             auto myTeam = state.env->getTeam(mySide);
             if(myTeam->numberOfBannedMembers() == 3 && currentState.env->getTeam(mySide)->numberOfBannedMembers() == 2 &&
                 !state.goalScoredThisRound) {
-                const auto &usedPlayers = mySide == gameModel::TeamSide::LEFT ? state.playersUsedLeft : state.playersUsedRight;
-                auto contains = [&usedPlayers](communication::messages::types::EntityId playerId){
-                    for(const auto &id : usedPlayers){
-                        if(id == playerId){
-                            return true;
-                        }
-                    }
-
-                    return false;
+                auto usedPlayers = gameHandling::toPlayerMask(mySide == gameModel::TeamSide::LEFT ? state.playersUsedLeft : state.playersUsedRight);
+                auto contains = [usedPlayers](communication::messages::types::EntityId playerId){
+                    return gameHandling::containsPlayer(usedPlayers, playerId);
                 };
 
                 bool canScoreGoal = false;
@@ -80,91 +99,161 @@ namespace ai{
             }
         }
 
-        auto tdErrorFun = [&reward, &state, this](const std::array<double, 1> &out, const std::array<double, 1> &){
-            auto tdError = reward + discountRate * stateEstimator.forward(state.getFeatureVec(mySide))[0] - out[0];
+        if(currentState.currentPhase == communication::messages::types::PhaseType::PLAYER_PHASE && side.has_value() && *side == mySide){
+            if(trainingOptions.tdMode == TdMode::TD0){
+                auto features = getFeatureVec(currentState);
+                auto next = getFeatureVec(state);
+                if(transitionSink){
+                    transitionSink({features, reward, next, mySide});
+                } else {
+                    train(features, reward + discountRate * bootstrapValue(next));
+                    if(mirrorPartner.has_value()){
+                        trainMirrored(features, reward + discountRate * mirroredBootstrapValue(next));
+                    }
+                }
+            } else {
+                trajectory.push_back({getFeatureVec(currentState), reward});
+                if(trajectory.size() >= trainingOptions.nStep){
+                    trainTrajectoryFront(getFeatureVec(state));
+                }
+            }
+        }
+
+        if(winningSide.has_value() && !trajectory.empty()){
+            // The game ended, the remaining transitions are trained with shorter returns
+            auto next = getFeatureVec(state);
+            while(!trajectory.empty()){
+                trainTrajectoryFront(next);
+            }
+        }
+
+        this->currentState = state;
+    }
+
+    void AI::train(const FeatureVec &features, double target) {
+        auto tdErrorFun = [target, this](const std::array<double, 1> &out, const std::array<double, 1> &){
+            auto tdError = target - out[0];
             log.debug(std::string("tdError: ") + std::to_string(tdError));
+            trainingStatistics.tdErrors++;
+            trainingStatistics.absTdErrorSum += std::abs(tdError);
+            trainingStatistics.maxAbsTdError = std::max(trainingStatistics.maxAbsTdError, std::abs(tdError));
             return tdError;
         };
 
-        if(currentState.currentPhase == communication::messages::types::PhaseType::PLAYER_PHASE && side.has_value() && *side == mySide){
-            auto stringSide = mySide == gameModel::TeamSide::LEFT ? "left: " : "right: ";
-            auto loss = stateEstimator.train({currentState.getFeatureVec(mySide)}, {{0}}, std::numeric_limits<double>::infinity(), tdErrorFun, learningRate);
-            log.info(std::string("Loss ") + stringSide + std::to_string(loss));
+        auto stringSide = mySide == gameModel::TeamSide::LEFT ? "left: " : "right: ";
+        auto loss = stateEstimator->train({features}, {{0}}, std::numeric_limits<double>::infinity(), tdErrorFun, learningRate);
+        log.info(std::string("Loss ") + stringSide + std::to_string(loss));
+        valueCache->invalidate();
+        trainingStatistics.tdUpdates++;
+        trainingStatistics.lossSum += loss;
+        if(targetNetwork){
+            targetNetwork->notifyUpdate();
         }
+    }
 
-        this->currentState = state;
+    void AI::trainMirrored(const FeatureVec &features, double target) {
+        auto tdErrorFun = [target](const std::array<double, 1> &out, const std::array<double, 1> &){
+            return target - out[0];
+        };
+
+        mirrorPartner->stateEstimator->train({FeatureEncoder::mirror(features)}, {{0}},
+                std::numeric_limits<double>::infinity(), tdErrorFun, learningRate);
+        mirrorPartner->valueCache->invalidate();
+        trainingStatistics.mirroredUpdates++;
+        if(mirrorPartner->targetNetwork){
+            mirrorPartner->targetNetwork->notifyUpdate();
+        }
     }
 
-    auto AI::getFeatureVec(const aiTools::State &state) const -> std::array<double, aiTools::State::FEATURE_VEC_LEN> {
-        std::array<double, aiTools::State::FEATURE_VEC_LEN> ret = {};
-        auto insertTeam = [&state](gameModel::TeamSide side, std::array<double, 120>::iterator &it){
-            auto &usedPlayers = side == gameModel::TeamSide::LEFT ? state.playersUsedLeft : state.playersUsedRight;
-            auto &availableFans = side == gameModel::TeamSide::LEFT ? state.availableFansLeft : state.availableFansRight;
-            for(const auto &player : state.env->getTeam(side)->getAllPlayers()){
-                *it++ = player->position.x;
-                *it++ = player->position.y;
-                bool used = false;
-                for(const auto &id : usedPlayers){
-                    if(player->getId() == id){
-                        used = true;
-                        break;
-                    }
+    void AI::trainTrajectoryFront(const FeatureVec &next) {
+        const auto &features = trajectory.front().features;
+        train(features, trajectoryTarget(next, [this](const FeatureVec &f){ return bootstrapValue(f); }));
+        if(mirrorPartner.has_value()){
+            trainMirrored(features, trajectoryTarget(next, [this](const FeatureVec &f){ return mirroredBootstrapValue(f); }));
+        }
+
+        trajectory.pop_front();
+    }
+
+    auto AI::bootstrapValue(const FeatureVec &features) const -> double {
+        return targetNetwork ? targetNetwork->forward(features) : stateEstimator->forward(features)[0];
+    }
+
+    auto AI::mirroredBootstrapValue(const FeatureVec &features) const -> double {
+        auto mirrored = FeatureEncoder::mirror(features);
+        return mirrorPartner->targetNetwork ? mirrorPartner->targetNetwork->forward(mirrored) :
+            mirrorPartner->stateEstimator->forward(mirrored)[0];
+    }
+
+    auto AI::trajectoryTarget(const FeatureVec &next, const FeatureEvalFun &bootstrap) const -> double {
+        auto lambda = trainingOptions.tdMode == TdMode::NStep ? 1.0 : trainingOptions.lambda;
+        double rewards = 0;
+        double discount = 1;
+        double weight = 1;
+        double target = 0;
+        for(std::size_t k = 1; k <= trajectory.size(); k++){
+            rewards += discount * trajectory[k - 1].reward;
+            discount *= discountRate;
+            if(k < trajectory.size()){
+                if(lambda < 1){
+                    target += (1 - lambda) * weight * (rewards + discount * bootstrap(trajectory[k].features));
                 }
 
-                *it++ = used;
-                *it++ = !used && !player->knockedOut && !player->isFined;
-                *it++ = player->knockedOut;
-                *it++ = player->isFined;
+                weight *= lambda;
+            } else {
+                target += weight * (rewards + discount * bootstrap(next));
             }
+        }
 
-            for(const auto &useNumber : availableFans){
-                *it++ = useNumber;
-            }
-        };
+        return target;
+    }
 
-        auto opponentSide = mySide == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
-        ret[0] = state.roundNumber;
-        ret[1] = static_cast<double>(state.currentPhase);
-        ret[2] = static_cast<double>(state.overtimeState);
-        ret[3] = state.overTimeCounter;
-        ret[4] = state.goalScoredThisRound;
-        ret[5] = state.env->getTeam(mySide)->score;
-        ret[6] = state.env->getTeam(opponentSide)->score;
-        auto it = ret.begin() + 7;
-        for(const auto &shit : state.env->pileOfShit){
-            *it++ = shit->position.x;
-            *it++ = shit->position.y;
-        }
-
-        for(unsigned long i = 0; i < 12 - state.env->pileOfShit.size(); i++){
-            *it++ = 0;
-            *it++ = 0;
-        }
-
-        ret[19] = state.env->quaffle->position.x;
-        ret[20] = state.env->quaffle->position.y;
-        ret[21] = state.env->bludgers[0]->position.x;
-        ret[22] = state.env->bludgers[0]->position.y;
-        ret[23] = state.env->bludgers[1]->position.x;
-        ret[24] = state.env->bludgers[1]->position.y;
-        ret[25] = state.env->snitch->position.x;
-        ret[26] = state.env->snitch->position.y;
-        ret[27] = state.env->snitch->exists;
-        it = ret.begin() + 28;
-        insertTeam(mySide, it);
-        insertTeam(opponentSide, it);
-        return ret;
+    auto AI::getFeatureVec(const aiTools::State &state) const -> FeatureVec {
+        return encoder.encode(state);
     }
 
     auto AI::getNextAction(const communication::messages::broadcast::Next &next) const ->
         std::optional<communication::messages::request::DeltaRequest> {
+        if(pool){
+            // The value cache is not thread safe
+            return getNextAction(next, [this](const FeatureVec &features){
+                return evaluator->forward(features)[0];
+            });
+        }
+
+        return getNextAction(next, [this](const FeatureVec &features){
+            auto cached = valueCache->lookup(features);
+            if(cached.has_value()){
+                return *cached;
+            }
+
+            auto value = evaluator->forward(features)[0];
+            valueCache->insert(features, value);
+            return value;
+        });
+    }
+
+    auto AI::getNextAction(const communication::messages::broadcast::Next &next, const FeatureEvalFun &featureEvalFun) const ->
+        std::optional<communication::messages::request::DeltaRequest> {
 
         if(gameLogic::conversions::idToSide(next.getEntityId()) != mySide){
             return std::nullopt;
         }
 
-        auto evalFun = [this](const aiTools::State &state){
-            return stateEstimator.forward(getFeatureVec(state))[0];
+        KITRAINING_PROFILE_PHASE(next.getTurnType() == communication::messages::types::TurnType::FAN ?
+                                 profiling::Phase::FanTurn : profiling::Phase::PlayerDecision);
+        KITRAINING_TRACE_SCOPE("AI::getNextAction");
+        if((searchOptions.makeUnmake || pool) && next.getTurnType() != communication::messages::types::TurnType::FAN){
+            return getNextActionMakeUnmake(next, featureEvalFun);
+        }
+
+        // Candidates only differ from the current state in a few entities, so the features are patched instead of rebuilt
+        auto baseFeatures = getFeatureVec(currentState);
+        DiffBase diffBase{currentState};
+        auto evalFun = [this, &featureEvalFun, &baseFeatures, &diffBase](const aiTools::State &state){
+            auto features = baseFeatures;
+            encoder.patch(features, state, FeatureEncoder::diff(diffBase, state));
+            return featureEvalFun(features);
         };
 
         switch (next.getTurnType()){
@@ -187,8 +276,11 @@ namespace ai{
                     throw std::runtime_error("Unexpected action type");
                 }
             }
-            case communication::messages::types::TurnType::FAN:
+            case communication::messages::types::TurnType::FAN:{
+                // Chooses the fan by chance with the random generator of the game logic
+                std::lock_guard<std::mutex> lock(gameHandling::gameLogicMutex());
                 return aiTools::getNextFanTurn(currentState, next);
+            }
             case communication::messages::types::TurnType::REMOVE_BAN:
                 log.info("Unban requested");
                 return aiTools::redeployPlayer(currentState, evalFun, next.getEntityId(), false);
@@ -196,4 +288,96 @@ namespace ai{
                 throw std::runtime_error("Enum out of bounds");
         }
     }
+
+    auto AI::getCandidates(const communication::messages::broadcast::Next &next, MakeUnmakeSearch &search) const ->
+        std::vector<MakeUnmakeSearch::Candidate> {
+        switch (next.getTurnType()){
+            case communication::messages::types::TurnType::MOVE:
+                log.info("Move requested");
+                return search.moveCandidates(next.getEntityId());
+            case communication::messages::types::TurnType::ACTION:{
+                auto type = gameController::getPossibleBallActionType(currentState.env->getPlayerById(next.getEntityId()), currentState.env);
+                if(!type.has_value()){
+                    throw std::runtime_error("No action possible");
+                }
+
+                if(*type == gameController::ActionType::Throw) {
+                    log.info("Throw requested");
+                    return search.shotCandidates(next.getEntityId());
+                } else if(*type == gameController::ActionType::Wrest) {
+                    log.info("Wrest requested");
+                    return search.wrestCandidates(next.getEntityId());
+                } else {
+                    throw std::runtime_error("Unexpected action type");
+                }
+            }
+            case communication::messages::types::TurnType::REMOVE_BAN:
+                log.info("Unban requested");
+                return search.redeployCandidates(next.getEntityId());
+            default:
+                throw std::runtime_error("Enum out of bounds");
+        }
+    }
+
+    auto AI::getNextActionMakeUnmake(const communication::messages::broadcast::Next &next, const FeatureEvalFun &evalFun) const ->
+        communication::messages::request::DeltaRequest {
+        MakeUnmakeSearch search{currentState, encoder, pool.get()};
+        return search.search(getCandidates(next, search), evalFun);
+    }
+
+    auto AI::searchPool(const SearchOptions &searchOptions) -> std::shared_ptr<ThreadPool> {
+        if(searchOptions.pool){
+            return searchOptions.pool->size() > 1 ? searchOptions.pool : nullptr;
+        }
+
+        return searchOptions.threads > 1 ? std::make_shared<ThreadPool>(searchOptions.threads) : nullptr;
+    }
+
+    auto AI::getSide() const -> gameModel::TeamSide {
+        return mySide;
+    }
+
+    void AI::invalidateCache() {
+        valueCache->invalidate();
+    }
+
+    void AI::shareCache(const AI &other) {
+        valueCache = other.valueCache;
+    }
+
+    void AI::setMirrorPartner(const AI &other) {
+        if(!stateEstimator || !other.stateEstimator || other.mySide == mySide || other.stateEstimator == stateEstimator){
+            throw std::runtime_error("Mirror partner has to play on the other side with a separate network");
+        }
+
+        mirrorPartner = MirrorPartner{other.stateEstimator, other.valueCache, other.targetNetwork};
+    }
+
+    void AI::setTransitionSink(TransitionSink sink) {
+        if(stateEstimator || trainingOptions.tdMode != TdMode::TD0){
+            throw std::runtime_error("Only AIs with a frozen network can emit TD(0) transitions");
+        }
+
+        transitionSink = std::move(sink);
+    }
+
+    auto AI::isLearning() const -> bool {
+        return stateEstimator != nullptr || transitionSink;
+    }
+
+    auto AI::getCache() const -> const ValueCache & {
+        return *valueCache;
+    }
+
+    auto AI::getTrainingStatistics() const -> const TrainingStatistics & {
+        return trainingStatistics;
+    }
+
+    auto TrainingStatistics::meanAbsTdError() const -> double {
+        return tdErrors == 0 ? 0 : absTdErrorSum / tdErrors;
+    }
+
+    auto TrainingStatistics::meanLoss() const -> double {
+        return tdUpdates == 0 ? 0 : lossSum / tdUpdates;
+    }
 }
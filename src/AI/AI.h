@@ -14,12 +14,110 @@
 #include <SopraMessages/DeltaRequest.hpp>
 #include <SopraAITools/AITools.h>
 #include <SopraUtil/Logging.hpp>
+#include <functional>
+#include <deque>
+#include "FeatureEncoder.h"
+#include "StateEstimator.h"
+#include "ValueCache.h"
+#include "MakeUnmakeSearch.h"
+#include "ThreadPool.h"
+#include "TargetNetwork.h"
 
 namespace ai {
+    /**
+     * Options selecting how the AI searches for its next action
+     */
+    struct SearchOptions {
+        bool makeUnmake = false; ///< Rate candidates with MakeUnmakeSearch instead of the AITools search functions
+        std::size_t threads = 1; ///< Rate candidates on this many threads, more than one implies makeUnmake
+        std::shared_ptr<ThreadPool> pool; ///< Rate candidates on this pool shared with other work instead, overrides threads
+        std::size_t cacheCapacity = 1U << 16U; ///< Entries of the value cache, no cache is used when rating on several threads
+
+        static constexpr std::size_t GAME_CACHE_CAPACITY = 1U << 12U; ///< Enough for AIs that only play a single game
+    };
+
+    /**
+     * Targets the stateEstimator is trained towards
+     */
+    enum class TdMode {
+        TD0, ///< One step TD target
+        NStep, ///< n-step return
+        Lambda ///< λ-return truncated after n steps
+    };
+
+    /**
+     * Options selecting how the AI learns
+     */
+    struct TrainingOptions {
+        TdMode tdMode = TdMode::TD0;
+        std::size_t nStep = 1; ///< Number of own steps in the returns of NStep and Lambda
+        double lambda = 0.9; ///< Weight of the longer returns in the λ-return
+        bool sharedNetwork = false; ///< Both teams use one network, the features of the right team are mirrored
+        bool mirrorAugmentation = false; ///< Every transition also trains the mirror partner with mirrored features
+    };
+
+    /**
+     * Training done by an AI
+     */
+    struct TrainingStatistics {
+        std::size_t tdUpdates = 0; ///< Training steps of the stateEstimator
+        std::size_t tdErrors = 0; ///< Number of computed TD errors
+        double absTdErrorSum = 0;
+        double maxAbsTdError = 0;
+        double lossSum = 0;
+        std::size_t mirroredUpdates = 0; ///< Training steps of the mirror partner's stateEstimator
+
+        auto meanAbsTdError() const -> double;
+        auto meanLoss() const -> double;
+    };
+
+    /**
+     * One own step of an AI in the player phase
+     */
+    struct Transition {
+        FeatureVec features; ///< The state before the step
+        double reward;
+        FeatureVec next; ///< The state after the step
+        gameModel::TeamSide side; ///< The team of the AI
+    };
+
+    /**
+     * Receives the transitions of an AI that does not train itself
+     */
+    using TransitionSink = std::function<void(Transition &&transition)>;
+
     class AI {
     public:
-        AI(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide mySide, double learningRate,
-           double discountRate, util::Logging log);
+        /**
+         * Constructor
+         * @param env
+         * @param mySide
+         * @param stateEstimator the value network to use and train, may be shared with other AIs
+         * @param learningRate
+         * @param discountRate
+         * @param log
+         * @param searchOptions
+         * @param trainingOptions
+         * @param targetNetwork frozen copy of the stateEstimator for the TD targets, nullptr to bootstrap from the
+         * stateEstimator itself
+         */
+        AI(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide mySide,
+           std::shared_ptr<StateEstimator> stateEstimator, double learningRate, double discountRate, util::Logging log,
+           SearchOptions searchOptions = {}, TrainingOptions trainingOptions = {},
+           std::shared_ptr<TargetNetwork> targetNetwork = nullptr);
+
+        /**
+         * Constructor of an AI that only plays and never trains
+         * @param env
+         * @param mySide
+         * @param frozenEstimator the value network to use, is only read and may be shared with AIs on other threads
+         * @param log
+         * @param searchOptions
+         * @param mirrored flip the x coordinates of the features, for networks trained on the other side of the pitch
+         */
+        AI(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide mySide,
+           std::shared_ptr<const StateEstimator> frozenEstimator, util::Logging log, SearchOptions searchOptions = {},
+           bool mirrored = false);
 
         /**
          * Updates the internal State
@@ -38,19 +136,176 @@ namespace ai {
         auto getNextAction(const communication::messages::broadcast::Next &next) const ->
             std::optional<communication::messages::request::DeltaRequest>;
 
-        ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1> stateEstimator;
+        /**
+         * Returns the AIs next action, all candidate states are rated by the given function instead of the stateEstimator
+         * @param next
+         * @param evalFun function rating the feature vector of a candidate state
+         * @return
+         */
+        auto getNextAction(const communication::messages::broadcast::Next &next, const FeatureEvalFun &evalFun) const ->
+            std::optional<communication::messages::request::DeltaRequest>;
+
+        /**
+         * Getter
+         * @return the TeamSide the AI is playing for
+         */
+        auto getSide() const -> gameModel::TeamSide;
+
+        /**
+         * Invalidates all cached state values. Is called by update whenever the stateEstimator is trained, has to be
+         * called manually if the stateEstimator is changed from outside of this AI.
+         */
+        void invalidateCache();
+
+        /**
+         * Uses the value cache of another AI, has to be called if both AIs use the same stateEstimator so that
+         * training by either AI invalidates the values cached by both
+         * @param other
+         */
+        void shareCache(const AI &other);
+
+        /**
+         * Trains the stateEstimator of another AI with the mirrored version of every transition of this AI. Only
+         * used with TrainingOptions::mirrorAugmentation, the other AI has to play on the other side with a separate
+         * stateEstimator that is not mirrored.
+         * @param other
+         */
+        void setMirrorPartner(const AI &other);
+
+        /**
+         * Hands every transition to a sink instead of training, e.g. to train on a different thread. Only for AIs
+         * with a frozen network and TD(0).
+         * @param sink
+         */
+        void setTransitionSink(TransitionSink sink);
+
+        /**
+         * @return false if the AI plays with a frozen network and neither trains nor emits transitions
+         */
+        auto isLearning() const -> bool;
+
+        /**
+         * Getter
+         * @return the value cache of the AI, for hit and miss statistics
+         */
+        auto getCache() const -> const ValueCache &;
+
+        /**
+         * Getter
+         * @return statistics of the training done by this AI
+         */
+        auto getTrainingStatistics() const -> const TrainingStatistics &;
+
+        std::shared_ptr<StateEstimator> stateEstimator; ///< The trained network, nullptr if the AI does not train
     private:
+        std::shared_ptr<const StateEstimator> evaluator; ///< The network rating candidates, stateEstimator or a frozen network
         aiTools::State currentState;
         const gameModel::TeamSide mySide;
+        FeatureEncoder encoder;
+        SearchOptions searchOptions;
+        std::shared_ptr<ThreadPool> pool; ///< Only created when searching on more than one thread
+        std::shared_ptr<ValueCache> valueCache; ///< Values of already evaluated states, only used without a pool
         double learningRate;
         double discountRate;
+        TrainingOptions trainingOptions;
+        std::shared_ptr<TargetNetwork> targetNetwork;
+        TrainingStatistics trainingStatistics;
         mutable util::Logging log;
 
+        TransitionSink transitionSink;
+
+        /**
+         * Own player phase steps that are not trained yet, only used with NStep and Lambda
+         */
+        struct TrajectoryStep {
+            FeatureVec features;
+            double reward;
+        };
+        std::deque<TrajectoryStep> trajectory;
+
+        /**
+         * Networks of the AI on the other side, trained with the mirrored transitions of this AI
+         */
+        struct MirrorPartner {
+            std::shared_ptr<StateEstimator> stateEstimator;
+            std::shared_ptr<ValueCache> valueCache;
+            std::shared_ptr<TargetNetwork> targetNetwork;
+        };
+        std::optional<MirrorPartner> mirrorPartner;
+
+        /**
+         * @param searchOptions
+         * @return the shared pool of the options or a new pool with their number of threads, nullptr if the candidates
+         * are rated on the calling thread
+         */
+        static auto searchPool(const SearchOptions &searchOptions) -> std::shared_ptr<ThreadPool>;
+
         /**
          * Computes a feature vextor from the given state
          * @return
          */
-        auto getFeatureVec(const aiTools::State &state) const -> std::array<double, aiTools::State::FEATURE_VEC_LEN>;
+        auto getFeatureVec(const aiTools::State &state) const -> FeatureVec;
+
+        /**
+         * @param features
+         * @return the value used for bootstrapping TD targets, from the target network if there is one
+         */
+        auto bootstrapValue(const FeatureVec &features) const -> double;
+
+        /**
+         * @param features unmirrored features
+         * @return the value of the mirrored features used for bootstrapping the TD targets of the mirror partner
+         */
+        auto mirroredBootstrapValue(const FeatureVec &features) const -> double;
+
+        /**
+         * Trains the stateEstimator towards a target
+         * @param features the state to train
+         * @param target
+         */
+        void train(const FeatureVec &features, double target);
+
+        /**
+         * Trains the stateEstimator of the mirror partner towards a target
+         * @param features the unmirrored state to train
+         * @param target target computed with mirroredBootstrapValue
+         */
+        void trainMirrored(const FeatureVec &features, double target);
+
+        /**
+         * Trains the oldest transition in the trajectory and, with mirror augmentation, its mirrored version
+         * @param next the state following the last transition
+         */
+        void trainTrajectoryFront(const FeatureVec &next);
+
+        /**
+         * Computes the target of the oldest transition in the trajectory. The k-step return G(k) bootstraps from the
+         * state of transition k or from next for the last one, the target is the λ-return
+         * (1 - λ) * sum(λ^(k-1) * G(k)) + λ^(n-1) * G(n), NStep uses λ = 1.
+         * @param next the state following the last transition
+         * @param bootstrap function returning the value of a state used for bootstrapping
+         * @return
+         */
+        auto trajectoryTarget(const FeatureVec &next, const FeatureEvalFun &bootstrap) const -> double;
+
+        /**
+         * Applies all candidate actions of a player turn
+         * @param next
+         * @param search search on the current state
+         * @return
+         */
+        auto getCandidates(const communication::messages::broadcast::Next &next, MakeUnmakeSearch &search) const ->
+            std::vector<MakeUnmakeSearch::Candidate>;
+
+        /**
+         * Computes the next player action with MakeUnmakeSearch
+         * @param next
+         * @param evalFun function rating the feature vector of a candidate state, has to be thread safe if the AI
+         * searches on more than one thread
+         * @return
+         */
+        auto getNextActionMakeUnmake(const communication::messages::broadcast::Next &next, const FeatureEvalFun &evalFun) const ->
+            communication::messages::request::DeltaRequest;
     };
 }
 
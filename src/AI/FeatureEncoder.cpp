@@ -0,0 +1,131 @@
+#include "FeatureEncoder.h"
+
+namespace ai {
+    auto FeatureDelta::all() -> FeatureDelta {
+        FeatureDelta delta;
+        delta.header = delta.pileOfShit = delta.quaffle = delta.bludger0 = delta.bludger1 = delta.snitch = true;
+        delta.fansLeft = delta.fansRight = true;
+        delta.players = static_cast<gameHandling::PlayerMask>((1u << (2 * gameHandling::PLAYERS_PER_TEAM)) - 1);
+        return delta;
+    }
+
+    DiffBase::DiffBase(const aiTools::State &state) : state(state),
+        usedLeft(gameHandling::toPlayerMask(state.playersUsedLeft)),
+        usedRight(gameHandling::toPlayerMask(state.playersUsedRight)) {}
+
+    FeatureEncoder::FeatureEncoder(gameModel::TeamSide mySide, bool mirrored) : mySide(mySide),
+        opponentSide(mySide == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT),
+        mirrorX(mirrored) {}
+
+    auto FeatureEncoder::encode(const aiTools::State &state) const -> FeatureVec {
+        FeatureVec features;
+        encode(state, features.data());
+        return features;
+    }
+
+    auto FeatureEncoder::diff(const aiTools::State &base, const aiTools::State &state) -> FeatureDelta {
+        return diff(DiffBase{base}, state);
+    }
+
+    auto FeatureEncoder::diff(const DiffBase &diffBase, const aiTools::State &state) -> FeatureDelta {
+        FeatureDelta delta;
+        const auto &base = diffBase.state;
+        const auto &baseEnv = *base.env;
+        const auto &env = *state.env;
+        delta.header = base.roundNumber != state.roundNumber || base.currentPhase != state.currentPhase ||
+                base.overtimeState != state.overtimeState || base.overTimeCounter != state.overTimeCounter ||
+                base.goalScoredThisRound != state.goalScoredThisRound || baseEnv.team1->score != env.team1->score ||
+                baseEnv.team2->score != env.team2->score;
+
+        if(baseEnv.pileOfShit.size() != env.pileOfShit.size()){
+            delta.pileOfShit = true;
+        } else {
+            for(std::size_t i = 0; i < env.pileOfShit.size(); i++){
+                if(baseEnv.pileOfShit[i]->position != env.pileOfShit[i]->position){
+                    delta.pileOfShit = true;
+                    break;
+                }
+            }
+        }
+
+        delta.quaffle = baseEnv.quaffle->position != env.quaffle->position;
+        delta.bludger0 = baseEnv.bludgers[0]->position != env.bludgers[0]->position;
+        delta.bludger1 = baseEnv.bludgers[1]->position != env.bludgers[1]->position;
+        delta.snitch = baseEnv.snitch->position != env.snitch->position || baseEnv.snitch->exists != env.snitch->exists;
+
+        auto usedChanged = static_cast<gameHandling::PlayerMask>(
+                (diffBase.usedLeft ^ gameHandling::toPlayerMask(state.playersUsedLeft)) |
+                (diffBase.usedRight ^ gameHandling::toPlayerMask(state.playersUsedRight)));
+        delta.players = usedChanged;
+        for(const auto &teams : {std::make_pair(baseEnv.team1.get(), env.team1.get()), std::make_pair(baseEnv.team2.get(), env.team2.get())}){
+            for(std::size_t i = 0; i < gameHandling::PLAYERS_PER_TEAM; i++){
+                const auto &basePlayer = playerAt(*teams.first, i);
+                const auto &player = playerAt(*teams.second, i);
+                if(basePlayer.position != player.position || basePlayer.knockedOut != player.knockedOut ||
+                    basePlayer.isFined != player.isFined){
+                    delta.players |= gameHandling::playerBit(player.getId());
+                }
+            }
+        }
+
+        delta.fansLeft = base.availableFansLeft != state.availableFansLeft;
+        delta.fansRight = base.availableFansRight != state.availableFansRight;
+        return delta;
+    }
+
+    auto FeatureEncoder::mirror(const FeatureVec &features) -> FeatureVec {
+        auto mirrored = features;
+        auto flip = [&mirrored](std::size_t offset){
+            mirrored[offset] = gameHandling::PITCH_WIDTH - 1 - mirrored[offset];
+        };
+
+        for(std::size_t i = 0; i < MAX_POO; i++){
+            // Unused slots are (0, 0), which is not a cell of the pitch
+            if(features[POO_OFFSET + 2 * i] != 0 || features[POO_OFFSET + 2 * i + 1] != 0){
+                flip(POO_OFFSET + 2 * i);
+            }
+        }
+
+        for(auto offset : {QUAFFLE_OFFSET, BLUDGER0_OFFSET, BLUDGER1_OFFSET, SNITCH_OFFSET}){
+            flip(offset);
+        }
+
+        for(auto teamOffset : {OWN_TEAM_OFFSET, OPPONENT_TEAM_OFFSET}){
+            for(std::size_t i = 0; i < gameHandling::PLAYERS_PER_TEAM; i++){
+                flip(teamOffset + i * PLAYER_FEATURES);
+            }
+        }
+
+        return mirrored;
+    }
+
+    void FeatureEncoder::patch(FeatureVec &features, const aiTools::State &state, const FeatureDelta &delta) const {
+        patch(features.data(), state, delta);
+    }
+
+    auto FeatureEncoder::playerAt(const gameModel::Team &team, std::size_t index) -> const gameModel::Player & {
+        switch (index){
+            case 0:
+                return *team.seeker;
+            case 1:
+                return *team.keeper;
+            case 2:
+            case 3:
+            case 4:
+                return *team.chasers[index - 2];
+            case 5:
+            case 6:
+                return *team.beaters[index - 5];
+            default:
+                throw std::runtime_error("Player index out of bounds");
+        }
+    }
+
+    auto FeatureEncoder::getSide() const -> gameModel::TeamSide {
+        return mySide;
+    }
+
+    auto FeatureEncoder::teamOffset(gameModel::TeamSide side) const -> std::size_t {
+        return side == mySide ? OWN_TEAM_OFFSET : OPPONENT_TEAM_OFFSET;
+    }
+}
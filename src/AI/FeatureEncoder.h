@@ -0,0 +1,282 @@
+#ifndef KITRAINING_FEATUREENCODER_H
+#define KITRAINING_FEATUREENCODER_H
+
+#include <array>
+#include <functional>
+#include <SopraAITools/AITools.h>
+#include <Game/GameTypes.h>
+
+namespace ai {
+    using FeatureVec = std::array<double, aiTools::State::FEATURE_VEC_LEN>;
+
+    /**
+     * Function returning the estimated value of a state given its feature vector
+     */
+    using FeatureEvalFun = std::function<double(const FeatureVec &)>;
+
+    /**
+     * Describes which parts of a state differ from a base state
+     */
+    struct FeatureDelta {
+        bool header = false; ///< Round, phase, overtime, goal flag or scores changed
+        bool pileOfShit = false; ///< Blocked cells changed
+        bool quaffle = false;
+        bool bludger0 = false;
+        bool bludger1 = false;
+        bool snitch = false;
+        gameHandling::PlayerMask players = 0; ///< Players whose position or flags changed
+        bool fansLeft = false; ///< Available fans of the left team changed
+        bool fansRight = false; ///< Available fans of the right team changed
+
+        /**
+         * @return a delta marking every part of the state as changed
+         */
+        static auto all() -> FeatureDelta;
+    };
+
+    /**
+     * Base state of a decision which many candidates are compared with. The used players are stored as sets in the
+     * state, their masks are computed once here instead of once per compared candidate.
+     */
+    struct DiffBase {
+        /**
+         * @param state the base state, has to outlive this object
+         */
+        explicit DiffBase(const aiTools::State &state);
+
+        const aiTools::State &state;
+        gameHandling::PlayerMask usedLeft; ///< Mask of playersUsedLeft of state
+        gameHandling::PlayerMask usedRight; ///< Mask of playersUsedRight of state
+    };
+
+    /**
+     * Computes the feature vector of a state relative to one team (own team first, opponent second). A mirrored
+     * encoder flips all x coordinates, so that e.g. the right team sees the pitch from the left side and can use a
+     * network trained for the left team.
+     * This is the only feature encoder, it is used for searching as well as for training.
+     * Besides encoding a state from scratch a feature vector of a base state can be patched with the changes of a
+     * different state, which only touches the slots of the changed entities.
+     * All functions writing to a raw buffer take a stride, feature i is written to out[i * stride]. A stride of one
+     * writes a row of a row major batch, a stride equal to the batch size writes a column of a structure of arrays batch.
+     */
+    class FeatureEncoder {
+    public:
+        /**
+         * Version of the layout below, saved with every network. Has to be increased with every change of the layout,
+         * networks saved with another layout rate meaningless inputs. Networks without a version use the layout of
+         * aiTools::State::getFeatureVec.
+         */
+        static constexpr unsigned int LAYOUT_VERSION = 2;
+        static constexpr std::size_t MAX_POO = 6;
+        static constexpr std::size_t HEADER_FEATURES = 7;
+        static constexpr std::size_t PLAYER_FEATURES = 6;
+        static constexpr std::size_t FAN_FEATURES = 5;
+        static constexpr std::size_t HEADER_OFFSET = 0;
+        static constexpr std::size_t POO_OFFSET = HEADER_OFFSET + HEADER_FEATURES;
+        static constexpr std::size_t QUAFFLE_OFFSET = POO_OFFSET + 2 * MAX_POO;
+        static constexpr std::size_t BLUDGER0_OFFSET = QUAFFLE_OFFSET + 2;
+        static constexpr std::size_t BLUDGER1_OFFSET = BLUDGER0_OFFSET + 2;
+        static constexpr std::size_t SNITCH_OFFSET = BLUDGER1_OFFSET + 2;
+        static constexpr std::size_t OWN_TEAM_OFFSET = SNITCH_OFFSET + 3;
+        static constexpr std::size_t TEAM_FEATURES = gameHandling::PLAYERS_PER_TEAM * PLAYER_FEATURES + FAN_FEATURES;
+        static constexpr std::size_t FAN_OFFSET = gameHandling::PLAYERS_PER_TEAM * PLAYER_FEATURES; ///< Relative to the team offset
+        static constexpr std::size_t OPPONENT_TEAM_OFFSET = OWN_TEAM_OFFSET + TEAM_FEATURES;
+        static constexpr std::size_t LENGTH = OPPONENT_TEAM_OFFSET + TEAM_FEATURES;
+        static_assert(LENGTH <= aiTools::State::FEATURE_VEC_LEN, "Feature layout does not fit into the network input");
+
+        /**
+         * Constructor
+         * @param mySide the team the features are relative to
+         * @param mirrored flip the x coordinates
+         */
+        explicit FeatureEncoder(gameModel::TeamSide mySide, bool mirrored = false);
+
+        /**
+         * Computes the complete feature vector of a state
+         * @param state
+         * @return
+         */
+        auto encode(const aiTools::State &state) const -> FeatureVec;
+
+        /**
+         * Writes the complete feature vector of a state into a caller provided buffer
+         * @tparam T scalar type of the buffer, usually float or double
+         * @param state
+         * @param out buffer with room for aiTools::State::FEATURE_VEC_LEN features at the given stride
+         * @param stride distance between two consecutive features in out
+         */
+        template<typename T>
+        void encode(const aiTools::State &state, T *out, std::size_t stride = 1) const;
+
+        /**
+         * Compares two states entity by entity
+         * @param base
+         * @param state
+         * @return the parts of state that differ from base
+         */
+        static auto diff(const aiTools::State &base, const aiTools::State &state) -> FeatureDelta;
+
+        /**
+         * Compares a state with a base state whose player masks are already known
+         * @param base
+         * @param state
+         * @return the parts of state that differ from base
+         */
+        static auto diff(const DiffBase &base, const aiTools::State &state) -> FeatureDelta;
+
+        /**
+         * Flips all x coordinates of a feature vector. As the features are relative to a team this is the feature
+         * vector of the same situation with both teams playing on the other side of the pitch.
+         * @param features
+         * @return
+         */
+        static auto mirror(const FeatureVec &features) -> FeatureVec;
+
+        /**
+         * Rewrites the slots of all changed entities
+         * @param features feature vector of the base state, afterwards the feature vector of state
+         * @param state the changed state
+         * @param delta the changes of state relative to the base state
+         */
+        void patch(FeatureVec &features, const aiTools::State &state, const FeatureDelta &delta) const;
+
+        /**
+         * Rewrites the slots of all changed entities in a caller provided buffer
+         * @tparam T scalar type of the buffer
+         * @param out features of the base state, afterwards the features of state
+         * @param state the changed state
+         * @param delta the changes of state relative to the base state
+         * @param stride distance between two consecutive features in out
+         */
+        template<typename T>
+        void patch(T *out, const aiTools::State &state, const FeatureDelta &delta, std::size_t stride = 1) const;
+
+        /**
+         * @param team
+         * @param index index in [0, PLAYERS_PER_TEAM): seeker, keeper, chasers, beaters
+         * @return the player at the given position of the feature layout
+         */
+        static auto playerAt(const gameModel::Team &team, std::size_t index) -> const gameModel::Player &;
+
+        /**
+         * Getter
+         * @return the side the features are relative to
+         */
+        auto getSide() const -> gameModel::TeamSide;
+
+    private:
+        gameModel::TeamSide mySide;
+        gameModel::TeamSide opponentSide;
+        bool mirrorX;
+
+        template<typename T>
+        static void set(T *out, std::size_t stride, std::size_t index, double value);
+
+        template<typename T>
+        void writePosition(T *out, std::size_t stride, std::size_t offset, const gameModel::Position &position) const;
+
+        auto teamOffset(gameModel::TeamSide side) const -> std::size_t;
+    };
+
+    template<typename T>
+    void FeatureEncoder::encode(const aiTools::State &state, T *out, std::size_t stride) const {
+        for(auto i = LENGTH; i < aiTools::State::FEATURE_VEC_LEN; i++){
+            set(out, stride, i, 0);
+        }
+
+        patch(out, state, FeatureDelta::all(), stride);
+    }
+
+    template<typename T>
+    void FeatureEncoder::patch(T *out, const aiTools::State &state, const FeatureDelta &delta, std::size_t stride) const {
+        const auto &env = *state.env;
+        if(delta.header){
+            set(out, stride, HEADER_OFFSET, state.roundNumber);
+            set(out, stride, HEADER_OFFSET + 1, static_cast<double>(state.currentPhase));
+            set(out, stride, HEADER_OFFSET + 2, static_cast<double>(state.overtimeState));
+            set(out, stride, HEADER_OFFSET + 3, state.overTimeCounter);
+            set(out, stride, HEADER_OFFSET + 4, state.goalScoredThisRound);
+            set(out, stride, HEADER_OFFSET + 5, env.getTeam(mySide)->score);
+            set(out, stride, HEADER_OFFSET + 6, env.getTeam(opponentSide)->score);
+        }
+
+        if(delta.pileOfShit){
+            std::size_t i = 0;
+            for(const auto &shit : env.pileOfShit){
+                if(i >= MAX_POO){
+                    break;
+                }
+
+                writePosition(out, stride, POO_OFFSET + 2 * i++, shit->position);
+            }
+
+            for(; i < MAX_POO; i++){
+                set(out, stride, POO_OFFSET + 2 * i, 0);
+                set(out, stride, POO_OFFSET + 2 * i + 1, 0);
+            }
+        }
+
+        if(delta.quaffle){
+            writePosition(out, stride, QUAFFLE_OFFSET, env.quaffle->position);
+        }
+
+        if(delta.bludger0){
+            writePosition(out, stride, BLUDGER0_OFFSET, env.bludgers[0]->position);
+        }
+
+        if(delta.bludger1){
+            writePosition(out, stride, BLUDGER1_OFFSET, env.bludgers[1]->position);
+        }
+
+        if(delta.snitch){
+            writePosition(out, stride, SNITCH_OFFSET, env.snitch->position);
+            set(out, stride, SNITCH_OFFSET + 2, env.snitch->exists);
+        }
+
+        if(delta.players != 0){
+            for(auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}){
+                const auto &team = *env.getTeam(side);
+                auto used = gameHandling::toPlayerMask(side == gameModel::TeamSide::LEFT ? state.playersUsedLeft : state.playersUsedRight);
+                for(std::size_t i = 0; i < gameHandling::PLAYERS_PER_TEAM; i++){
+                    const auto &player = playerAt(team, i);
+                    if(!gameHandling::containsPlayer(delta.players, player.getId())){
+                        continue;
+                    }
+
+                    auto offset = teamOffset(side) + i * PLAYER_FEATURES;
+                    bool isUsed = gameHandling::containsPlayer(used, player.getId());
+                    writePosition(out, stride, offset, player.position);
+                    set(out, stride, offset + 2, isUsed);
+                    set(out, stride, offset + 3, !isUsed && !player.knockedOut && !player.isFined);
+                    set(out, stride, offset + 4, player.knockedOut);
+                    set(out, stride, offset + 5, player.isFined);
+                }
+            }
+        }
+
+        if(delta.fansLeft){
+            for(std::size_t i = 0; i < FAN_FEATURES; i++){
+                set(out, stride, teamOffset(gameModel::TeamSide::LEFT) + FAN_OFFSET + i, state.availableFansLeft[i]);
+            }
+        }
+
+        if(delta.fansRight){
+            for(std::size_t i = 0; i < FAN_FEATURES; i++){
+                set(out, stride, teamOffset(gameModel::TeamSide::RIGHT) + FAN_OFFSET + i, state.availableFansRight[i]);
+            }
+        }
+    }
+
+    template<typename T>
+    void FeatureEncoder::set(T *out, std::size_t stride, std::size_t index, double value) {
+        out[index * stride] = static_cast<T>(value);
+    }
+
+    template<typename T>
+    void FeatureEncoder::writePosition(T *out, std::size_t stride, std::size_t offset, const gameModel::Position &position) const {
+        set(out, stride, offset, mirrorX ? gameHandling::PITCH_WIDTH - 1 - position.x : position.x);
+        set(out, stride, offset + 1, position.y);
+    }
+}
+
+#endif //KITRAINING_FEATUREENCODER_H
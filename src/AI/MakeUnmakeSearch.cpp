@@ -0,0 +1,315 @@
+#include <limits>
+#include <SopraGameLogic/GameController.h>
+#include <SopraGameLogic/conversions.h>
+#include "MakeUnmakeSearch.h"
+
+namespace ai {
+    MakeUnmakeSearch::MakeUnmakeSearch(const aiTools::State &state, const FeatureEncoder &encoder, ThreadPool *pool) :
+                                       base(state), encoder(encoder), pool(pool), baseFeatures(encoder.encode(state)), diffBase(state) {
+        scratches.resize(pool == nullptr ? 1 : pool->size());
+        occupants.fill(0);
+        for(const auto &team : {state.env->team1.get(), state.env->team2.get()}){
+            for(std::size_t i = 0; i < gameHandling::PLAYERS_PER_TEAM; i++){
+                const auto &player = FeatureEncoder::playerAt(*team, i);
+                if(gameModel::Environment::getCell(player.position) != gameModel::Cell::OutOfBounds){
+                    occupants[cellIndex(player.position)] |= gameHandling::playerBit(player.getId());
+                }
+            }
+        }
+    }
+
+    auto MakeUnmakeSearch::moveCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate> {
+        using namespace communication::messages::types;
+        auto origin = base.env->getPlayerById(id)->position;
+        std::vector<gameModel::Position> targets;
+        for(int dx = -1; dx <= 1; dx++){
+            for(int dy = -1; dy <= 1; dy++){
+                gameModel::Position target{origin.x + dx, origin.y + dy};
+                if((dx != 0 || dy != 0) && gameModel::Environment::getCell(target) != gameModel::Cell::OutOfBounds){
+                    targets.emplace_back(target);
+                }
+            }
+        }
+
+        auto candidates = collect(skip(id), targets, [this, id](Scratch &scratch, const gameModel::Position &target){
+            auto &state = scratch.state;
+            gameController::Move move(state.env, state.env->getPlayerById(id), target);
+            auto check = move.check();
+            if(check == gameController::ActionCheckResult::Impossible){
+                return std::optional<Candidate>{};
+            }
+
+            // Only fouls and moves onto a ball have random outcomes, executing them would draw from the random
+            // generator of the game logic
+            if(check == gameController::ActionCheckResult::Foul || containsBall(target)){
+                return std::optional<Candidate>{Candidate{makeRequest(DeltaType::MOVE, id, target), outcomes(scratch, move)}};
+            }
+
+            move.execute();
+            Candidate candidate{makeRequest(DeltaType::MOVE, id, target), {outcome(state, moveDelta(id, target))}};
+            scratch.undoLog.revert(*state.env);
+            return std::optional<Candidate>{std::move(candidate)};
+        });
+
+        return candidates;
+    }
+
+    auto MakeUnmakeSearch::shotCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate> {
+        using namespace communication::messages::types;
+        auto deltaType = DeltaType::QUAFFLE_THROW;
+        std::optional<EntityId> passive;
+        auto player = base.env->getPlayerById(id);
+        if(INSTANCE_OF(player, gameModel::Beater)){
+            deltaType = DeltaType::BLUDGER_BEATING;
+            passive = base.env->bludgers[0]->position == player->position ? base.env->bludgers[0]->getId() : base.env->bludgers[1]->getId();
+        }
+
+        markUsed(id);
+        return collect(skip(id), allCells(), [this, id, passive, deltaType](Scratch &scratch, const gameModel::Position &target){
+            auto &state = scratch.state;
+            std::shared_ptr<gameModel::Ball> ball = state.env->quaffle;
+            if(passive.has_value()){
+                ball = state.env->bludgers[0]->getId() == *passive ? state.env->bludgers[0] : state.env->bludgers[1];
+            }
+
+            gameController::Shot shot(state.env, state.env->getPlayerById(id), ball, target);
+            if(shot.check() == gameController::ActionCheckResult::Impossible){
+                return std::optional<Candidate>{};
+            }
+
+            return std::optional<Candidate>{Candidate{makeRequest(deltaType, id, target, passive), outcomes(scratch, shot)}};
+        });
+    }
+
+    auto MakeUnmakeSearch::wrestCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate> {
+        using namespace communication::messages::types;
+        auto &scratch = getScratch(0);
+        auto player = std::dynamic_pointer_cast<gameModel::Chaser>(scratch.state.env->getPlayerById(id));
+        if(!player){
+            throw std::runtime_error("Wresting player is no Chaser");
+        }
+
+        markUsed(id);
+        std::vector<Candidate> candidates{skip(id)};
+        gameController::WrestQuaffle wrest(scratch.state.env, player, scratch.state.env->quaffle->position);
+        if(wrest.check() != gameController::ActionCheckResult::Impossible){
+            candidates.emplace_back(Candidate{makeRequest(DeltaType::WREST_QUAFFLE, id), outcomes(scratch, wrest)});
+        }
+
+        return candidates;
+    }
+
+    auto MakeUnmakeSearch::redeployCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate> {
+        using namespace communication::messages::types;
+        std::vector<gameModel::Position> targets;
+        for(const auto &cell : allCells()){
+            if(!gameModel::Environment::isGoalCell(cell) && base.env->cellIsFree(cell)){
+                targets.emplace_back(cell);
+            }
+        }
+
+        auto candidates = collect(std::nullopt, targets, [this, id](Scratch &scratch, const gameModel::Position &target){
+            auto player = scratch.state.env->getPlayerById(id);
+            player->position = target;
+            player->isFined = false;
+            Candidate candidate{makeRequest(DeltaType::UNBAN, id, target), {outcome(scratch.state, playerDelta(id))}};
+            scratch.undoLog.revert(*scratch.state.env);
+            return std::optional<Candidate>{std::move(candidate)};
+        });
+
+        if(candidates.empty()){
+            candidates.emplace_back(Candidate{makeRequest(DeltaType::SKIP, id), {}});
+        }
+
+        return candidates;
+    }
+
+    auto MakeUnmakeSearch::expectedValues(const std::vector<Candidate> &candidates, const FeatureEvalFun &evalFun,
+                                          ThreadPool *pool) -> std::vector<double> {
+        std::vector<double> values(candidates.size(), 0);
+        auto rate = [&](std::size_t task, std::size_t){
+            for(const auto &outcome : candidates[task].outcomes){
+                values[task] += outcome.probability * evalFun(outcome.features);
+            }
+        };
+
+        if(pool == nullptr){
+            for(std::size_t i = 0; i < candidates.size(); i++){
+                rate(i, 0);
+            }
+        } else {
+            pool->run(candidates.size(), rate);
+        }
+
+        return values;
+    }
+
+    auto MakeUnmakeSearch::choose(const std::vector<Candidate> &candidates, const std::vector<double> &values) ->
+        communication::messages::request::DeltaRequest {
+        if(candidates.empty() || values.size() != candidates.size()){
+            throw std::runtime_error("Every candidate needs exactly one value");
+        }
+
+        std::size_t best = 0;
+        for(std::size_t i = 1; i < candidates.size(); i++){
+            if(values[i] > values[best]){
+                best = i;
+            }
+        }
+
+        return candidates[best].request;
+    }
+
+    auto MakeUnmakeSearch::search(const std::vector<Candidate> &candidates, const FeatureEvalFun &evalFun) const ->
+        communication::messages::request::DeltaRequest {
+        if(candidates.size() == 1){
+            return candidates.front().request;
+        }
+
+        return choose(candidates, expectedValues(candidates, evalFun, pool));
+    }
+
+    auto MakeUnmakeSearch::collect(std::optional<Candidate> first, const std::vector<gameModel::Position> &targets,
+                                   const CandidateFun &candidateFun) -> std::vector<Candidate> {
+        std::vector<std::optional<Candidate>> found(targets.size());
+        auto apply = [&](std::size_t task, std::size_t worker){
+            found[task] = candidateFun(getScratch(worker), targets[task]);
+        };
+
+        if(pool == nullptr){
+            for(std::size_t i = 0; i < targets.size(); i++){
+                apply(i, 0);
+            }
+        } else {
+            pool->run(targets.size(), apply);
+        }
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(targets.size() + 1);
+        if(first.has_value()){
+            candidates.emplace_back(std::move(*first));
+        }
+
+        for(auto &candidate : found){
+            if(candidate.has_value()){
+                candidates.emplace_back(std::move(*candidate));
+            }
+        }
+
+        return candidates;
+    }
+
+    auto MakeUnmakeSearch::skip(communication::messages::types::EntityId id) const -> Candidate {
+        // Skipping does not change the environment, the state shares the one of the base state
+        auto state = base;
+        if(usedPlayer.has_value()){
+            markUsed(state, *usedPlayer);
+        }
+
+        return {makeRequest(communication::messages::types::DeltaType::SKIP, id), {outcome(state, playerDelta(id))}};
+    }
+
+    auto MakeUnmakeSearch::getScratch(std::size_t worker) -> Scratch & {
+        auto &scratch = scratches[worker];
+        if(!scratch.has_value()){
+            scratch.emplace(Scratch{base, {}});
+            scratch->state.env = base.env->clone();
+            if(usedPlayer.has_value()){
+                markUsed(scratch->state, *usedPlayer);
+            }
+
+            scratch->undoLog.save(*scratch->state.env);
+        }
+
+        return *scratch;
+    }
+
+    auto MakeUnmakeSearch::outcomes(Scratch &scratch, const gameController::Action &action) const -> std::vector<Outcome> {
+        std::vector<Outcome> result;
+        for(auto &possibleOutcome : action.executeAll()){
+            // The outcome is encoded in place of the scratch environment, which executeAll does not modify. It is a
+            // new environment without undo log, so its changes have to be found by comparing it with the base state.
+            std::swap(scratch.state.env, possibleOutcome.first);
+            auto &added = result.emplace_back(outcome(scratch.state, FeatureEncoder::diff(diffBase, scratch.state)));
+            added.probability = possibleOutcome.second;
+            std::swap(scratch.state.env, possibleOutcome.first);
+        }
+
+        return result;
+    }
+
+    auto MakeUnmakeSearch::outcome(const aiTools::State &state, const FeatureDelta &delta) const -> Outcome {
+        Outcome result{baseFeatures, 1};
+        encoder.patch(result.features, state, delta);
+        return result;
+    }
+
+    auto MakeUnmakeSearch::playerDelta(communication::messages::types::EntityId id) -> FeatureDelta {
+        FeatureDelta delta;
+        delta.players = gameHandling::playerBit(id);
+        return delta;
+    }
+
+    auto MakeUnmakeSearch::moveDelta(communication::messages::types::EntityId id, const gameModel::Position &target) const ->
+        FeatureDelta {
+        // A move changes the mover, a player pushed away from the target cell, the balls the mover carries or catches
+        // and, by scoring or catching the snitch, the scores. Bans only change the flags of the mover.
+        auto delta = playerDelta(id);
+        delta.players |= occupants[cellIndex(target)];
+        delta.header = delta.quaffle = delta.bludger0 = delta.bludger1 = delta.snitch = true;
+        return delta;
+    }
+
+    bool MakeUnmakeSearch::containsBall(const gameModel::Position &cell) const {
+        return base.env->quaffle->position == cell || base.env->bludgers[0]->position == cell ||
+               base.env->bludgers[1]->position == cell || (base.env->snitch->exists && base.env->snitch->position == cell);
+    }
+
+    auto MakeUnmakeSearch::cellIndex(const gameModel::Position &cell) -> std::size_t {
+        return static_cast<std::size_t>(cell.y * PITCH_WIDTH + cell.x);
+    }
+
+    void MakeUnmakeSearch::markUsed(communication::messages::types::EntityId id) {
+        usedPlayer = id;
+        for(auto &scratch : scratches){
+            if(scratch.has_value()){
+                markUsed(scratch->state, id);
+            }
+        }
+    }
+
+    void MakeUnmakeSearch::markUsed(aiTools::State &state, communication::messages::types::EntityId id) {
+        auto &used = gameLogic::conversions::idToSide(id) == gameModel::TeamSide::LEFT ?
+                state.playersUsedLeft : state.playersUsedRight;
+        used.emplace(id);
+    }
+
+    auto MakeUnmakeSearch::allCells() -> std::vector<gameModel::Position> {
+        std::vector<gameModel::Position> cells;
+        cells.reserve(PITCH_WIDTH * PITCH_HEIGHT);
+        for(int x = 0; x < PITCH_WIDTH; x++){
+            for(int y = 0; y < PITCH_HEIGHT; y++){
+                gameModel::Position cell{x, y};
+                if(gameModel::Environment::getCell(cell) != gameModel::Cell::OutOfBounds){
+                    cells.emplace_back(cell);
+                }
+            }
+        }
+
+        return cells;
+    }
+
+    auto MakeUnmakeSearch::makeRequest(communication::messages::types::DeltaType type, communication::messages::types::EntityId active,
+                                       std::optional<gameModel::Position> target,
+                                       std::optional<communication::messages::types::EntityId> passive) ->
+                                       communication::messages::request::DeltaRequest {
+        std::optional<int> x, y;
+        if(target.has_value()){
+            x = target->x;
+            y = target->y;
+        }
+
+        return {type, std::nullopt, std::nullopt, std::nullopt, x, y, active, passive, std::nullopt, std::nullopt,
+                std::nullopt, std::nullopt, std::nullopt};
+    }
+}
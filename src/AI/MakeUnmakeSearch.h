@@ -0,0 +1,214 @@
+#ifndef KITRAINING_MAKEUNMAKESEARCH_H
+#define KITRAINING_MAKEUNMAKESEARCH_H
+
+#include <array>
+#include <optional>
+#include <vector>
+#include <SopraAITools/AITools.h>
+#include <SopraMessages/DeltaRequest.hpp>
+#include "FeatureEncoder.h"
+#include "ThreadPool.h"
+#include "UndoLog.h"
+
+namespace ai {
+    /**
+     * Searches the best player action by applying every candidate to one mutable copy of the environment, rating the
+     * result and reverting the candidate with an UndoLog. The environment is cloned once per decision instead of
+     * once per candidate. Actions with random outcomes (throws, bludger shots, wrests, fouls and moves onto a ball) are
+     * rated like in AITools by the expected value over all their outcomes, which the game logic enumerates with cloned
+     * environments. Only actions without random outcome are executed, so the search never draws from the random
+     * generator shared by all games and searches of different games do not lock each other.
+     * With a thread pool the candidates are split over the workers, each working on its own copy of the environment.
+     * A worker only clones the environment once it applies a candidate of the search, so a search of a busy pool does
+     * not clone it for every worker.
+     */
+    class MakeUnmakeSearch {
+    public:
+        static constexpr int PITCH_WIDTH = gameHandling::PITCH_WIDTH;
+        static constexpr int PITCH_HEIGHT = gameHandling::PITCH_HEIGHT;
+
+        /**
+         * One possible result of a candidate
+         */
+        struct Outcome {
+            FeatureVec features; ///< Features of the state after the candidate
+            double probability;
+        };
+
+        /**
+         * A possible action, rated by the expected value of its outcomes
+         */
+        struct Candidate {
+            communication::messages::request::DeltaRequest request;
+            std::vector<Outcome> outcomes;
+        };
+
+        /**
+         * Constructor
+         * @param state the current state, is not modified
+         * @param encoder encoder for the side of the searching AI
+         * @param pool optional pool to apply and rate the candidates in parallel
+         */
+        MakeUnmakeSearch(const aiTools::State &state, const FeatureEncoder &encoder, ThreadPool *pool = nullptr);
+
+        /**
+         * @param id the player to move
+         * @return staying (a skip) followed by every possible move
+         */
+        auto moveCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate>;
+
+        /**
+         * @param id the player holding the quaffle or a bludger
+         * @return not throwing (a skip) followed by every possible quaffle throw or bludger shot
+         */
+        auto shotCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate>;
+
+        /**
+         * @param id the chaser which can wrest the quaffle
+         * @return not wresting (a skip) followed by the wrest if it is possible
+         */
+        auto wrestCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate>;
+
+        /**
+         * @param id the banned player
+         * @return an unban request for every free cell, a skip if there is none
+         */
+        auto redeployCandidates(communication::messages::types::EntityId id) -> std::vector<Candidate>;
+
+        /**
+         * Rates candidates by the probability weighted values of their outcomes
+         * @param candidates
+         * @param evalFun function rating a feature vector, has to be thread safe if a pool is used
+         * @param pool optional pool to rate the candidates in parallel
+         * @return the value of every candidate
+         */
+        static auto expectedValues(const std::vector<Candidate> &candidates, const FeatureEvalFun &evalFun,
+                                   ThreadPool *pool = nullptr) -> std::vector<double>;
+
+        /**
+         * @param candidates
+         * @param values the value of every candidate
+         * @return the request of the best rated candidate, the first one on ties
+         */
+        static auto choose(const std::vector<Candidate> &candidates, const std::vector<double> &values) ->
+            communication::messages::request::DeltaRequest;
+
+        /**
+         * Rates the candidates on the pool of the search and chooses the best one
+         * @param candidates
+         * @param evalFun function rating a feature vector, has to be thread safe if a pool is used
+         * @return the request of the best rated candidate
+         */
+        auto search(const std::vector<Candidate> &candidates, const FeatureEvalFun &evalFun) const ->
+            communication::messages::request::DeltaRequest;
+
+    private:
+        /**
+         * Copy of the base state with its own environment, modified by the candidates of one worker
+         */
+        struct Scratch {
+            aiTools::State state;
+            UndoLog undoLog;
+        };
+
+        /**
+         * Applies a candidate to a scratch state and reverts it afterwards
+         * @return nullopt if the candidate is impossible
+         */
+        using CandidateFun = std::function<std::optional<Candidate>(Scratch &scratch, const gameModel::Position &target)>;
+
+        const aiTools::State &base;
+        const FeatureEncoder &encoder;
+        ThreadPool *pool;
+        std::vector<std::optional<Scratch>> scratches; ///< One per worker, created by getScratch
+        std::optional<communication::messages::types::EntityId> usedPlayer; ///< Player marked as used in all scratch states
+        FeatureVec baseFeatures;
+        DiffBase diffBase; ///< Compared with the outcomes of executeAll
+        std::array<gameHandling::PlayerMask, PITCH_WIDTH * PITCH_HEIGHT> occupants; ///< Players on every cell of the base state
+
+        /**
+         * Creates the candidates of all targets
+         * @param first candidate placed before all others, e.g. a skip
+         * @param targets target cell of every candidate
+         * @param candidateFun
+         * @return the possible candidates in the order of the targets
+         */
+        auto collect(std::optional<Candidate> first, const std::vector<gameModel::Position> &targets,
+                     const CandidateFun &candidateFun) -> std::vector<Candidate>;
+
+        /**
+         * @param id
+         * @return the candidate of not acting with the player, the state only differs in the used player
+         */
+        auto skip(communication::messages::types::EntityId id) const -> Candidate;
+
+        /**
+         * Encodes all outcomes of an action with their probabilities
+         * @param scratch the state the action belongs to
+         * @param action
+         * @return
+         */
+        auto outcomes(Scratch &scratch, const gameController::Action &action) const -> std::vector<Outcome>;
+
+        /**
+         * Encodes a state, the features are patched from the features of the base state
+         * @param state
+         * @param delta the parts of state which may differ from the base state, known from the applied action so
+         * that the state does not have to be compared with the base state
+         * @return the state as an outcome with probability 1
+         */
+        auto outcome(const aiTools::State &state, const FeatureDelta &delta) const -> Outcome;
+
+        /**
+         * @param id
+         * @return delta of a state in which only the player was used, moved or redeployed
+         */
+        static auto playerDelta(communication::messages::types::EntityId id) -> FeatureDelta;
+
+        /**
+         * @param id the moving player
+         * @param target
+         * @return delta of all entities a move of the player to target can change
+         */
+        auto moveDelta(communication::messages::types::EntityId id, const gameModel::Position &target) const -> FeatureDelta;
+
+        /**
+         * @param cell
+         * @return true if the quaffle, a bludger or the snitch is on the cell in the base state
+         */
+        bool containsBall(const gameModel::Position &cell) const;
+
+        /**
+         * @param cell a cell inside the pitch
+         * @return index of the cell in occupants
+         */
+        static auto cellIndex(const gameModel::Position &cell) -> std::size_t;
+
+        /**
+         * Returns the scratch state of a worker, its environment is cloned from the base state on the first call
+         * @param worker
+         * @return
+         */
+        auto getScratch(std::size_t worker) -> Scratch &;
+
+        /**
+         * Marks the player as used in all scratch states, including the ones created later
+         * @param id
+         */
+        void markUsed(communication::messages::types::EntityId id);
+
+        static void markUsed(aiTools::State &state, communication::messages::types::EntityId id);
+
+        /**
+         * @return all cells inside the pitch
+         */
+        static auto allCells() -> std::vector<gameModel::Position>;
+
+        static auto makeRequest(communication::messages::types::DeltaType type, communication::messages::types::EntityId active,
+                                std::optional<gameModel::Position> target = std::nullopt,
+                                std::optional<communication::messages::types::EntityId> passive = std::nullopt) ->
+                                communication::messages::request::DeltaRequest;
+    };
+}
+
+#endif //KITRAINING_MAKEUNMAKESEARCH_H
@@ -0,0 +1,49 @@
+#include <fstream>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include <Mlp/Util.h>
+#include "FeatureEncoder.h"
+#include "NetFile.h"
+
+namespace ai {
+    constexpr auto LAYOUT_KEY = "featureLayout";
+
+    auto featureLayoutOf(const std::string &fileName) -> std::optional<unsigned int> {
+        std::ifstream file{fileName};
+        if(!file.good()){
+            throw std::runtime_error("Could not open network " + fileName);
+        }
+
+        nlohmann::json json;
+        file >> json;
+        if(json.count(LAYOUT_KEY) == 0){
+            return std::nullopt;
+        }
+
+        return json.at(LAYOUT_KEY).get<unsigned int>();
+    }
+
+    auto loadNet(const std::string &fileName) -> StateEstimator {
+        auto layout = featureLayoutOf(fileName);
+        if(layout != FeatureEncoder::LAYOUT_VERSION){
+            throw std::runtime_error("Network " + fileName + " was trained with feature layout " +
+                (layout.has_value() ? std::to_string(*layout) : std::string{"1 (no version)"}) + ", the current layout is " +
+                std::to_string(FeatureEncoder::LAYOUT_VERSION) + ". Retrain the network.");
+        }
+
+        return ml::util::loadFromFile<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>(fileName);
+    }
+
+    void saveNet(const std::string &fileName, const StateEstimator &net) {
+        ml::util::saveToFile(fileName, net);
+        nlohmann::json json;
+        {
+            std::ifstream file{fileName};
+            file >> json;
+        }
+
+        json[LAYOUT_KEY] = FeatureEncoder::LAYOUT_VERSION;
+        std::ofstream file{fileName};
+        file << json;
+    }
+}
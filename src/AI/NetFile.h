@@ -0,0 +1,31 @@
+#ifndef KITRAINING_NETFILE_H
+#define KITRAINING_NETFILE_H
+
+#include <optional>
+#include <string>
+#include "StateEstimator.h"
+
+namespace ai {
+    /**
+     * Reads the feature layout a network was trained with
+     * @param fileName network in the json format of ml::util::saveToFile
+     * @return the FeatureEncoder::LAYOUT_VERSION stored by saveNet, nullopt if the network has no version
+     */
+    auto featureLayoutOf(const std::string &fileName) -> std::optional<unsigned int>;
+
+    /**
+     * Loads a network, throws a std::runtime_error if it was not trained with the current feature layout
+     * @param fileName
+     * @return
+     */
+    auto loadNet(const std::string &fileName) -> StateEstimator;
+
+    /**
+     * Saves a network together with the current feature layout version
+     * @param fileName
+     * @param net
+     */
+    void saveNet(const std::string &fileName, const StateEstimator &net);
+}
+
+#endif //KITRAINING_NETFILE_H
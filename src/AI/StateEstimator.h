@@ -0,0 +1,11 @@
+#ifndef KITRAINING_STATEESTIMATOR_H
+#define KITRAINING_STATEESTIMATOR_H
+
+#include <Mlp/Mlp.hpp>
+#include <SopraAITools/AITools.h>
+
+namespace ai {
+    using StateEstimator = ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>;
+}
+
+#endif //KITRAINING_STATEESTIMATOR_H
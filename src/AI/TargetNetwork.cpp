@@ -0,0 +1,41 @@
+#include <stdexcept>
+#include "TargetNetwork.h"
+
+namespace ai {
+    constexpr auto targetCacheSize = 1U << 16U;
+
+    TargetNetwork::TargetNetwork(std::shared_ptr<const StateEstimator> online, std::size_t syncInterval) :
+        online(std::move(online)), frozen(*this->online), syncInterval(syncInterval), cache(targetCacheSize) {
+        if(syncInterval == 0){
+            throw std::runtime_error("Target network sync interval has to be at least 1");
+        }
+    }
+
+    auto TargetNetwork::forward(const FeatureVec &features) const -> double {
+        auto cached = cache.lookup(features);
+        if(cached.has_value()){
+            return *cached;
+        }
+
+        auto value = frozen.forward(features)[0];
+        cache.insert(features, value);
+        return value;
+    }
+
+    void TargetNetwork::notifyUpdate() {
+        if(++updatesSinceSync >= syncInterval){
+            sync();
+        }
+    }
+
+    void TargetNetwork::sync() {
+        frozen = *online;
+        updatesSinceSync = 0;
+        syncs++;
+        cache.invalidate();
+    }
+
+    auto TargetNetwork::getSyncs() const -> std::size_t {
+        return syncs;
+    }
+}
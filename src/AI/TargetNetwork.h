@@ -0,0 +1,56 @@
+#ifndef KITRAINING_TARGETNETWORK_H
+#define KITRAINING_TARGETNETWORK_H
+
+#include <memory>
+#include "FeatureEncoder.h"
+#include "StateEstimator.h"
+#include "ValueCache.h"
+
+namespace ai {
+    /**
+     * Frozen copy of a value network used for the bootstrapped part of the TD targets. The copy is synchronised with
+     * the online network every syncInterval training steps, in between its values do not change and are cached.
+     * Not thread safe, all AIs training the online network have to share one TargetNetwork.
+     */
+    class TargetNetwork {
+    public:
+        /**
+         * Constructor, copies the current weights of the online network
+         * @param online the trained network
+         * @param syncInterval number of training steps of the online network between two synchronisations
+         */
+        TargetNetwork(std::shared_ptr<const StateEstimator> online, std::size_t syncInterval);
+
+        /**
+         * @param features
+         * @return the value of the state according to the frozen network
+         */
+        auto forward(const FeatureVec &features) const -> double;
+
+        /**
+         * Has to be called after every training step of the online network, synchronises every syncInterval calls
+         */
+        void notifyUpdate();
+
+        /**
+         * Copies the current weights of the online network
+         */
+        void sync();
+
+        /**
+         * Getter
+         * @return number of synchronisations, including the initial copy
+         */
+        auto getSyncs() const -> std::size_t;
+
+    private:
+        std::shared_ptr<const StateEstimator> online;
+        StateEstimator frozen;
+        std::size_t syncInterval;
+        std::size_t updatesSinceSync = 0;
+        std::size_t syncs = 1;
+        mutable ValueCache cache;
+    };
+}
+
+#endif //KITRAINING_TARGETNETWORK_H
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include "ThreadPool.h"
+
+namespace ai {
+    namespace {
+        /**
+         * Pool and worker index of the calling thread, nullptr for threads of no pool
+         */
+        thread_local const ThreadPool *workerPool = nullptr;
+        thread_local std::size_t workerIndex = 0;
+    }
+
+    ThreadPool::ThreadPool(std::size_t size) {
+        if(size == 0){
+            throw std::runtime_error("Thread pool needs at least one worker");
+        }
+
+        deques.reserve(size);
+        for(std::size_t worker = 0; worker < size; worker++){
+            deques.emplace_back(std::make_unique<Deque>());
+        }
+
+        threads.reserve(size - 1);
+        for(std::size_t worker = 1; worker < size; worker++){
+            threads.emplace_back(&ThreadPool::work, this, worker);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+
+        jobQueued.notify_all();
+        for(auto &thread : threads){
+            thread.join();
+        }
+    }
+
+    void ThreadPool::run(std::size_t taskCount, const Task &task) {
+        if(threads.empty() || taskCount <= 1){
+            for(std::size_t i = 0; i < taskCount; i++){
+                task(i, 0);
+            }
+
+            return;
+        }
+
+        auto worker = currentWorker();
+        Group group{taskCount - 1, nullptr, {}, {}};
+        auto call = [&task, &group](std::size_t i, std::size_t executingWorker){
+            try {
+                task(i, executingWorker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(group.mutex);
+                if(!group.error){
+                    group.error = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<Job> jobs;
+        jobs.reserve(taskCount - 1);
+        // The back of the deque is popped first, so the tasks of this worker run in index order
+        for(auto i = taskCount - 1; i > 0; i--){
+            jobs.emplace_back(Job{[&call, &group, i](std::size_t executingWorker){
+                call(i, executingWorker);
+                // The waiting thread destroys group once remaining is 0, so it is only touched under the lock
+                std::lock_guard<std::mutex> lock(group.mutex);
+                if(--group.remaining == 0){
+                    group.finished.notify_all();
+                }
+            }, &group});
+        }
+
+        push(worker, std::move(jobs));
+        call(0, worker);
+        Job job;
+        while(pop(worker, job, &group)){
+            job.fun(worker);
+        }
+
+        // The remaining tasks are executed by other workers
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.finished.wait(lock, [&group]{ return group.remaining == 0; });
+        if(group.error){
+            std::rethrow_exception(group.error);
+        }
+    }
+
+    auto ThreadPool::size() const -> std::size_t {
+        return deques.size();
+    }
+
+    auto ThreadPool::currentWorker() const -> std::size_t {
+        return workerPool == this ? workerIndex : 0;
+    }
+
+    void ThreadPool::push(std::size_t worker, std::vector<Job> &&jobs) {
+        auto count = jobs.size();
+        {
+            std::lock_guard<std::mutex> lock(deques[worker]->mutex);
+            for(auto &job : jobs){
+                deques[worker]->jobs.emplace_back(std::move(job));
+            }
+        }
+
+        queuedJobs += count;
+        {
+            // Sleeping workers check queuedJobs under this lock, taking it avoids lost wake ups
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+
+        if(count == 1){
+            jobQueued.notify_one();
+        } else {
+            jobQueued.notify_all();
+        }
+    }
+
+    bool ThreadPool::pop(std::size_t worker, Job &job, const void *group) {
+        auto matches = [group](const Job &queued){
+            return group == nullptr || queued.group == group;
+        };
+
+        {
+            auto &own = *deques[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            auto it = std::find_if(own.jobs.rbegin(), own.jobs.rend(), matches);
+            if(it != own.jobs.rend()){
+                job = std::move(*it);
+                own.jobs.erase(std::next(it).base());
+                queuedJobs--;
+                return true;
+            }
+        }
+
+        for(std::size_t offset = 1; offset < deques.size(); offset++){
+            auto &victim = *deques[(worker + offset) % deques.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            auto it = std::find_if(victim.jobs.begin(), victim.jobs.end(), matches);
+            if(it != victim.jobs.end()){
+                job = std::move(*it);
+                victim.jobs.erase(it);
+                queuedJobs--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::work(std::size_t worker) {
+        workerPool = this;
+        workerIndex = worker;
+        Job job;
+        while(true){
+            if(pop(worker, job)){
+                job.fun(worker);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            jobQueued.wait(lock, [this]{ return stopping || queuedJobs > 0; });
+            if(stopping && queuedJobs == 0){
+                return;
+            }
+        }
+    }
+}
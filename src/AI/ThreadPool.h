@@ -0,0 +1,135 @@
+#ifndef KITRAINING_THREADPOOL_H
+#define KITRAINING_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ai {
+    /**
+     * Fixed size work-stealing pool. Every worker owns a deque of tasks, it pushes and pops its own tasks at the back
+     * and idle workers steal from the front of the other deques. A thread waiting in run() executes the queued tasks of
+     * that run and sleeps once the remaining ones are executed by other workers, so tasks may start runs of their own
+     * (games rating their candidates on the pool that runs the games) without unrelated work, like another game,
+     * ending up on their stack. The thread owning the pool takes part as worker 0, so a pool of size n starts n - 1
+     * threads.
+     */
+    class ThreadPool {
+    public:
+        using Task = std::function<void(std::size_t task, std::size_t worker)>;
+
+        /**
+         * Constructor
+         * @param size number of workers including the calling thread, at least 1
+         */
+        explicit ThreadPool(std::size_t size);
+
+        /**
+         * Destructor, finishes all submitted tasks
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+        /**
+         * Calls task for every index in [0, taskCount) distributed over all workers and blocks until all calls
+         * finished. May be called by the thread owning the pool and by tasks of the pool. Calls with the same worker
+         * index are never concurrent. The first exception thrown by task is rethrown once all calls finished.
+         * @param taskCount
+         * @param task called with the task index and the index of the executing worker in [0, size())
+         */
+        void run(std::size_t taskCount, const Task &task);
+
+        /**
+         * Queues a task without waiting for it, a pool of size 1 calls it immediately. May be called by the thread
+         * owning the pool and by tasks of the pool.
+         * @tparam F
+         * @param fun
+         * @return the result of fun
+         */
+        template<typename F>
+        auto submit(F &&fun) -> std::future<std::invoke_result_t<F>>;
+
+        /**
+         * @return number of workers including the calling thread
+         */
+        auto size() const -> std::size_t;
+
+    private:
+        struct Job {
+            std::function<void(std::size_t worker)> fun;
+            const void *group = nullptr; ///< The run() waiting for the job, nullptr for submitted jobs
+        };
+
+        /**
+         * State of one call of run(), shared by its jobs
+         */
+        struct Group {
+            std::size_t remaining; ///< Jobs which did not finish yet
+            std::exception_ptr error;
+            std::mutex mutex; ///< Guards remaining and error
+            std::condition_variable finished;
+        };
+
+        struct Deque {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        std::vector<std::unique_ptr<Deque>> deques; ///< One per worker
+        std::vector<std::thread> threads;
+        std::atomic<std::size_t> queuedJobs = 0;
+        std::mutex sleepMutex;
+        std::condition_variable jobQueued;
+        bool stopping = false;
+
+        /**
+         * @return the index of the calling thread, 0 if it is no thread of this pool
+         */
+        auto currentWorker() const -> std::size_t;
+
+        /**
+         * Queues jobs at the back of the deque of a worker and wakes the sleeping workers
+         * @param worker
+         * @param jobs
+         */
+        void push(std::size_t worker, std::vector<Job> &&jobs);
+
+        /**
+         * Pops the newest job of the worker or steals the oldest job of another worker
+         * @param worker
+         * @param job the found job
+         * @param group only take jobs of this run(), any job if nullptr
+         * @return false if no deque contains a matching job
+         */
+        bool pop(std::size_t worker, Job &job, const void *group = nullptr);
+
+        void work(std::size_t worker);
+    };
+
+    template<typename F>
+    auto ThreadPool::submit(F &&fun) -> std::future<std::invoke_result_t<F>> {
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(fun));
+        auto result = task->get_future();
+        if(threads.empty()){
+            (*task)();
+        } else {
+            std::vector<Job> jobs;
+            jobs.emplace_back(Job{[task](std::size_t){ (*task)(); }});
+            push(currentWorker(), std::move(jobs));
+        }
+
+        return result;
+    }
+}
+
+#endif //KITRAINING_THREADPOOL_H
@@ -0,0 +1,59 @@
+#include "UndoLog.h"
+
+namespace ai {
+    namespace {
+        /**
+         * Calls fun for every player of a team in the order seeker, keeper, chasers, beaters without building a
+         * container of the players
+         */
+        template<typename Fun>
+        void forEachPlayer(const gameModel::Team &team, const Fun &fun) {
+            fun(*team.seeker);
+            fun(*team.keeper);
+            for(const auto &chaser : team.chasers){
+                fun(*chaser);
+            }
+
+            for(const auto &beater : team.beaters){
+                fun(*beater);
+            }
+        }
+    }
+
+    void UndoLog::save(const gameModel::Environment &env) {
+        std::size_t i = 0;
+        for(const auto &team : {env.team1.get(), env.team2.get()}){
+            forEachPlayer(*team, [this, &i](const gameModel::Player &player){
+                players[i++] = {player.position, player.knockedOut, player.isFined};
+            });
+        }
+
+        quaffle = env.quaffle->position;
+        bludger0 = env.bludgers[0]->position;
+        bludger1 = env.bludgers[1]->position;
+        snitch = env.snitch->position;
+        snitchExists = env.snitch->exists;
+        scoreTeam1 = env.team1->score;
+        scoreTeam2 = env.team2->score;
+    }
+
+    void UndoLog::revert(gameModel::Environment &env) const {
+        std::size_t i = 0;
+        for(const auto &team : {env.team1.get(), env.team2.get()}){
+            forEachPlayer(*team, [this, &i](gameModel::Player &player){
+                const auto &record = players[i++];
+                player.position = record.position;
+                player.knockedOut = record.knockedOut;
+                player.isFined = record.isFined;
+            });
+        }
+
+        env.quaffle->position = quaffle;
+        env.bludgers[0]->position = bludger0;
+        env.bludgers[1]->position = bludger1;
+        env.snitch->position = snitch;
+        env.snitch->exists = snitchExists;
+        env.team1->score = scoreTeam1;
+        env.team2->score = scoreTeam2;
+    }
+}
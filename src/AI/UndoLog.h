@@ -0,0 +1,43 @@
+#ifndef KITRAINING_UNDOLOG_H
+#define KITRAINING_UNDOLOG_H
+
+#include <array>
+#include <SopraGameLogic/GameModel.h>
+#include <Game/GameTypes.h>
+
+namespace ai {
+    /**
+     * Records all parts of an environment that can be changed by a player action (moves, shots, wrests and unbans)
+     * in fixed size storage, so that an action can be applied to an environment and reverted afterwards without
+     * cloning the environment.
+     */
+    class UndoLog {
+    public:
+        /**
+         * Records the current state of the environment
+         * @param env
+         */
+        void save(const gameModel::Environment &env);
+
+        /**
+         * Restores the last recorded state, the environment has to be the one passed to save
+         * @param env
+         */
+        void revert(gameModel::Environment &env) const;
+
+    private:
+        struct PlayerRecord {
+            gameModel::Position position;
+            bool knockedOut;
+            bool isFined;
+        };
+
+        std::array<PlayerRecord, 2 * gameHandling::PLAYERS_PER_TEAM> players = {};
+        gameModel::Position quaffle, bludger0, bludger1, snitch;
+        bool snitchExists = false;
+        int scoreTeam1 = 0;
+        int scoreTeam2 = 0;
+    };
+}
+
+#endif //KITRAINING_UNDOLOG_H
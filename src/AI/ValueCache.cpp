@@ -0,0 +1,62 @@
+#include <cstring>
+#include "ValueCache.h"
+
+namespace ai {
+    ValueCache::ValueCache(std::size_t capacity) {
+        std::size_t size = 1;
+        while(size < capacity){
+            size <<= 1U;
+        }
+
+        entries.resize(size);
+        mask = size - 1;
+    }
+
+    auto ValueCache::lookup(const FeatureVec &features) -> std::optional<double> {
+        auto key = hash(features);
+        const auto &entry = entries[key.slot & mask];
+        if(entry.generation == generation && entry.key == key){
+            hits++;
+            return entry.value;
+        }
+
+        misses++;
+        return std::nullopt;
+    }
+
+    void ValueCache::insert(const FeatureVec &features, double value) {
+        auto key = hash(features);
+        entries[key.slot & mask] = {key, generation, value};
+    }
+
+    void ValueCache::invalidate() {
+        generation++;
+    }
+
+    auto ValueCache::getHits() const -> std::uint64_t {
+        return hits;
+    }
+
+    auto ValueCache::getMisses() const -> std::uint64_t {
+        return misses;
+    }
+
+    auto ValueCache::hash(const FeatureVec &features) -> Key {
+        // Different seeds, combining steps and multipliers keep the two hashes independent
+        Key key{0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL};
+        for(const auto &feature : features){
+            std::uint64_t bits;
+            std::memcpy(&bits, &feature, sizeof(bits));
+            key.slot = (key.slot ^ bits) * 0x9e3779b97f4a7c15ULL;
+            key.slot ^= key.slot >> 29U;
+            key.check = (key.check + bits) * 0xbf58476d1ce4e5b9ULL;
+            key.check ^= key.check >> 31U;
+        }
+
+        return key;
+    }
+
+    bool ValueCache::Key::operator==(const Key &other) const {
+        return slot == other.slot && check == other.check;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef KITRAINING_VALUECACHE_H
+#define KITRAINING_VALUECACHE_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "FeatureEncoder.h"
+
+namespace ai {
+    /**
+     * Bounded, direct mapped cache from feature vectors to state values.
+     * Entries are keyed by two independent 64 bit hashes of the feature vector, one selects the slot and both are
+     * compared, so a wrong value needs a collision of all 128 bits. Invalidating the cache is O(1).
+     */
+    class ValueCache {
+    public:
+        /**
+         * Constructor
+         * @param capacity number of entries, rounded up to the next power of two
+         */
+        explicit ValueCache(std::size_t capacity);
+
+        /**
+         * Looks up the value of a feature vector, counts a hit or a miss
+         * @param features
+         * @return the cached value, nullopt if not cached
+         */
+        auto lookup(const FeatureVec &features) -> std::optional<double>;
+
+        /**
+         * Stores the value of a feature vector, replaces the entry with the same slot
+         * @param features
+         * @param value
+         */
+        void insert(const FeatureVec &features, double value);
+
+        /**
+         * Invalidates all entries, has to be called whenever the network computing the values changes
+         */
+        void invalidate();
+
+        auto getHits() const -> std::uint64_t;
+        auto getMisses() const -> std::uint64_t;
+
+        /**
+         * Two independent hashes of a feature vector
+         */
+        struct Key {
+            std::uint64_t slot; ///< Selects the entry
+            std::uint64_t check; ///< Compared in addition to slot
+
+            bool operator==(const Key &other) const;
+        };
+
+        /**
+         * @param features
+         * @return hashes of the bit patterns of all features
+         */
+        static auto hash(const FeatureVec &features) -> Key;
+
+    private:
+        struct Entry {
+            Key key{0, 0};
+            std::uint64_t generation = 0; ///< Generation the entry was written in, 0 is never valid
+            double value = 0;
+        };
+
+        std::vector<Entry> entries;
+        std::uint64_t mask; ///< entries.size() - 1
+        std::uint64_t generation = 1; ///< Current generation, entries of older generations are invalid
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+}
+
+#endif //KITRAINING_VALUECACHE_H
@@ -5,44 +5,48 @@
 #include <SopraGameLogic/conversions.h>
 #include <SopraAITools/AITools.h>
 #include <Mlp/Util.h>
+#include <Profiling/Tracer.h>
 #include "Communicator.h"
 
 communication::Communicator::Communicator(const communication::messages::broadcast::MatchConfig &matchConfig,
                                           const communication::messages::request::TeamConfig &leftTeamConfig,
                                           const communication::messages::request::TeamConfig &rightTeamConfig,
                                           util::Logging &log, double learningRate, double discountRate,
-                                          const std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-                            ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>> &mlps, std::string expDir)
+                                          const Nets &mlps, std::string expDir, std::uint64_t seed, ai::SearchOptions searchOptions,
+                                          ai::TrainingOptions trainingOptions, const TargetNets &targetNets,
+                                          const FrozenNets &frozenNets)
                                           : game{matchConfig, leftTeamConfig, rightTeamConfig,
                                                  aiTools::getTeamFormation(gameModel::TeamSide::LEFT),
-                                                 aiTools::getTeamFormation(gameModel::TeamSide::RIGHT), log, std::move(expDir)},
-                                            ais{std::make_pair(
-                                                    ai::AI{game.environment, gameModel::TeamSide::LEFT, learningRate, discountRate, log},
-                                                    ai::AI{game.environment, gameModel::TeamSide::RIGHT, learningRate, discountRate, log})},
+                                                 aiTools::getTeamFormation(gameModel::TeamSide::RIGHT), log, std::move(expDir), seed},
+                                            ais{makeAIs(game.environment, log, learningRate, discountRate, mlps, searchOptions, trainingOptions,
+                                                    targetNets, frozenNets)},
                                                     log{log} {
-    run(mlps);
+    run();
 }
 
 communication::Communicator::Communicator(const communication::messages::broadcast::MatchConfig &matchConfig,
                                           const aiTools::State &state, util::Logging &log, double learningRate,
-                                          double discountRate,
-                                          const std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-                                                  ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>> &mlps,
-                                          std::string expDir) : game{matchConfig, state, log, std::move(expDir)},
-                                          ais(std::make_pair(ai::AI{game.environment, gameModel::TeamSide::LEFT, learningRate, discountRate, log},
-                                                  ai::AI{game.environment, gameModel::TeamSide::RIGHT, learningRate, discountRate, log})), log(log){
-    run(mlps);
+                                          double discountRate, const Nets &mlps,
+                                          std::string expDir, std::uint64_t seed, ai::SearchOptions searchOptions,
+                                          ai::TrainingOptions trainingOptions, const TargetNets &targetNets,
+                                          const FrozenNets &frozenNets) : game{matchConfig, state, log, std::move(expDir), seed},
+                                          ais(makeAIs(game.environment, log, learningRate, discountRate, mlps, searchOptions, trainingOptions,
+                                                  targetNets, frozenNets)), log(log){
+    run();
 }
 
-void communication::Communicator::run(const std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-        ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>> &nets) {
-    ais.first.stateEstimator = nets.first;
-    ais.second.stateEstimator = nets.second;
+void communication::Communicator::run() {
+    statistics = playGame(game, ais, log);
+}
 
+auto communication::playGame(gameHandling::Game &game, std::pair<ai::AI, ai::AI> &ais, util::Logging &log) -> GameStatistics {
+    KITRAINING_TRACE_SCOPE("Communicator::run");
+    GameStatistics statistics;
     auto next = game.getNextAction();
 
     while (!game.winEvent.has_value()) {
         std::optional<gameModel::TeamSide> lastTeamSide;
+        statistics.steps++;
 
         if (gameLogic::conversions::isBall(next.getEntityId())) {
             game.executeBallDelta(next.getEntityId());
@@ -50,6 +54,7 @@ void communication::Communicator::run(const std::pair<ml::Mlp<aiTools::State::FE
         } else {
             auto action1 = ais.first.getNextAction(next);
             auto action2 = ais.second.getNextAction(next);
+            statistics.decisions++;
 
             if (action1.has_value() && action2.has_value()) {
                 throw std::runtime_error("Both players want to perform an action!");
@@ -76,9 +81,54 @@ void communication::Communicator::run(const std::pair<ml::Mlp<aiTools::State::FE
     ais.first.update(game.getState(), winTuple.first, winTuple.first);
     ais.second.update(game.getState(), winTuple.first, winTuple.first);
 
+    statistics.rounds = game.getState().roundNumber;
+    statistics.result = winTuple;
+    statistics.trainingLeft = ais.first.getTrainingStatistics();
+    statistics.trainingRight = ais.second.getTrainingStatistics();
     log.info("Game finished:");
     log.info(messages::types::toString(winTuple.second));
+    for(const auto &ai : {&ais.first, &ais.second}){
+        log.debug("Value cache hits: " + std::to_string(ai->getCache().getHits()) + ", misses: " +
+            std::to_string(ai->getCache().getMisses()));
+    }
+
+    return statistics;
+}
+
+auto communication::makeAIs(const std::shared_ptr<gameModel::Environment> &env, util::Logging &log, double learningRate,
+                            double discountRate, const Nets &nets, ai::SearchOptions searchOptions,
+                            ai::TrainingOptions trainingOptions, const TargetNets &targetNets,
+                            const FrozenNets &frozenNets) -> std::pair<ai::AI, ai::AI> {
+    auto makeAI = [&](gameModel::TeamSide side, const std::shared_ptr<ai::StateEstimator> &net,
+            const std::shared_ptr<const ai::StateEstimator> &frozenNet, const std::shared_ptr<ai::TargetNetwork> &targetNet){
+        if(frozenNet){
+            return ai::AI{env, side, frozenNet, log, searchOptions,
+                          trainingOptions.sharedNetwork && side == gameModel::TeamSide::RIGHT};
+        }
+
+        return ai::AI{env, side, net, learningRate, discountRate, log, searchOptions, trainingOptions, targetNet};
+    };
+
+    auto ais = std::make_pair(makeAI(gameModel::TeamSide::LEFT, nets.first, frozenNets.first, targetNets.first),
+            makeAI(gameModel::TeamSide::RIGHT, nets.second, frozenNets.second, targetNets.second));
+    if(!ais.first.isLearning() || !ais.second.isLearning()){
+        return ais;
+    }
+
+    if(nets.first == nets.second){
+        ais.second.shareCache(ais.first);
+    } else if(trainingOptions.mirrorAugmentation){
+        ais.first.setMirrorPartner(ais.second);
+        ais.second.setMirrorPartner(ais.first);
+    }
+
+    return ais;
+}
+
+auto communication::GameStatistics::tdUpdates() const -> std::size_t {
+    return trainingLeft.tdUpdates + trainingRight.tdUpdates;
+}
 
-    this->mlps.first = ais.first.stateEstimator;
-    this->mlps.second = ais.second.stateEstimator;
+auto communication::Communicator::getStatistics() const -> GameStatistics {
+    return statistics;
 }
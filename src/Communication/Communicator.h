@@ -10,30 +10,91 @@
 #include <Game/Game.h>
 
 namespace communication {
+    /**
+     * Value networks of the left and the right team
+     */
+    using Nets = std::pair<std::shared_ptr<ai::StateEstimator>, std::shared_ptr<ai::StateEstimator>>;
+
+    /**
+     * Target networks of the left and the right team, both nullptr if training bootstraps from the Nets directly
+     */
+    using TargetNets = std::pair<std::shared_ptr<ai::TargetNetwork>, std::shared_ptr<ai::TargetNetwork>>;
+
+    /**
+     * Read only networks of the left and the right team, a team with a frozen network plays it without training
+     * instead of its network in Nets. Both nullptr for self play.
+     */
+    using FrozenNets = std::pair<std::shared_ptr<const ai::StateEstimator>, std::shared_ptr<const ai::StateEstimator>>;
+
+    /**
+     * Work done while playing one game
+     */
+    struct GameStatistics {
+        std::size_t steps = 0; ///< Turns of balls and players
+        std::size_t decisions = 0; ///< Player turns decided by an AI
+        int rounds = 0;
+        std::optional<std::pair<gameModel::TeamSide, messages::types::VictoryReason>> result;
+        ai::TrainingStatistics trainingLeft;
+        ai::TrainingStatistics trainingRight;
+
+        /**
+         * @return training steps of both AIs
+         */
+        auto tdUpdates() const -> std::size_t;
+    };
+
+    /**
+     * Creates the AIs of one game. Learning AIs sharing a network share their value cache, with mirror augmentation
+     * learning AIs with separate networks train each other's network.
+     */
+    auto makeAIs(const std::shared_ptr<gameModel::Environment> &env, util::Logging &log, double learningRate,
+            double discountRate, const Nets &nets, ai::SearchOptions searchOptions, ai::TrainingOptions trainingOptions,
+            const TargetNets &targetNets, const FrozenNets &frozenNets) -> std::pair<ai::AI, ai::AI>;
+
+    /**
+     * Plays a game until it is finished, both AIs are updated after every step
+     * @param game
+     * @param ais the left and the right AI
+     * @param log
+     * @return statistics of the game
+     */
+    auto playGame(gameHandling::Game &game, std::pair<ai::AI, ai::AI> &ais, util::Logging &log) -> GameStatistics;
+
     class Communicator {
     public:
+        /**
+         * Plays one game and trains the given networks in place
+         */
         Communicator(const messages::broadcast::MatchConfig &matchConfig,
                 const messages::request::TeamConfig &leftTeamConfig,
                 const messages::request::TeamConfig &rightTeamConfig,
                 util::Logging &log, double learningRate, double discountRate,
-                const std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-                ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>> &mlps, std::string expDir);
+                const Nets &mlps, std::string expDir, std::uint64_t seed, ai::SearchOptions searchOptions = {},
+                ai::TrainingOptions trainingOptions = {}, const TargetNets &targetNets = {},
+                const FrozenNets &frozenNets = {});
 
 
+        /**
+         * Plays one game starting from a saved experience and trains the given networks in place
+         */
         Communicator(const messages::broadcast::MatchConfig &matchConfig, const aiTools::State &state,
                 util::Logging &log, double learningRate, double discountRate,
-                const std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-                ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>> &mlps, std::string expDir);
+                const Nets &mlps, std::string expDir, std::uint64_t seed, ai::SearchOptions searchOptions = {},
+                ai::TrainingOptions trainingOptions = {}, const TargetNets &targetNets = {},
+                const FrozenNets &frozenNets = {});
 
-        std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-            ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>> mlps;
+        /**
+         * Getter
+         * @return statistics of the played game
+         */
+        auto getStatistics() const -> GameStatistics;
 
     private:
         gameHandling::Game game;
         std::pair<ai::AI, ai::AI> ais;
         util::Logging &log;
-        void run(const std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-                            ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>> &nets);
+        GameStatistics statistics;
+        void run();
     };
 }
 
@@ -0,0 +1,79 @@
+#include <mutex>
+#include <thread>
+#include "ActorClient.h"
+#include "Protocol.h"
+
+namespace distributed {
+    constexpr std::size_t TRANSITIONS_PER_MESSAGE = 64;
+
+    ActorClient::ActorClient(const std::string &address, simulation::Actor actor) :
+        socket(Socket::connect(address)), actor(std::move(actor)) {
+        sendMessage(socket, MessageType::Hello, encodeHello());
+    }
+
+    void ActorClient::run(std::uint64_t seed, const std::atomic<bool> &stopping) {
+        communication::FrozenNets nets;
+        auto requestWeights = [this, &nets]{
+            sendMessage(socket, MessageType::WeightsRequest, {});
+            auto message = receiveMessage(socket);
+            if(message.type == MessageType::Weights){
+                nets = decodeWeights(message.payload);
+            } else if(message.type != MessageType::WeightsUnchanged || !nets.first){
+                throw std::runtime_error("Expected weights from the learner");
+            }
+        };
+
+        requestWeights();
+        std::vector<ai::Transition> pending;
+        auto sink = [this, &pending](ai::Transition &&transition){
+            pending.emplace_back(std::move(transition));
+            if(pending.size() >= TRANSITIONS_PER_MESSAGE){
+                sendMessage(socket, MessageType::Transitions, encodeTransitions(pending));
+                pending.clear();
+            }
+        };
+
+        for(std::uint64_t game = 0; !stopping; game++){
+            auto statistics = actor.play(nets, seed + game, sink);
+            if(!pending.empty()){
+                sendMessage(socket, MessageType::Transitions, encodeTransitions(pending));
+                pending.clear();
+            }
+
+            sendMessage(socket, MessageType::GameFinished, encodeGame(statistics));
+            requestWeights();
+        }
+    }
+
+    void runActors(const std::string &address, std::size_t actorCount, std::uint64_t seed,
+                   const simulation::Actor &actor) {
+        std::atomic<bool> stopping{false};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < actorCount; i++){
+            threads.emplace_back([&, i]{
+                try {
+                    ActorClient client{address, actor};
+                    client.run(seed + (static_cast<std::uint64_t>(i) << 32u), stopping);
+                } catch (...) {
+                    // Also errors of the json parser and the Mlp while loading the weights
+                    std::lock_guard<std::mutex> lock{errorMutex};
+                    if(!error){
+                        error = std::current_exception();
+                    }
+
+                    stopping = true;
+                }
+            });
+        }
+
+        for(auto &thread : threads){
+            thread.join();
+        }
+
+        if(error){
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef KITRAINING_ACTORCLIENT_H
+#define KITRAINING_ACTORCLIENT_H
+
+#include <atomic>
+#include <Simulation/Actor.h>
+#include "Socket.h"
+
+namespace distributed {
+    /**
+     * Plays games for a LearnerServer over one connection
+     */
+    class ActorClient {
+    public:
+        /**
+         * Constructor, connects to the server
+         * @param address unix:<path> or tcp:<host>:<port>
+         * @param actor plays the games, has to use the network mode of the server
+         */
+        ActorClient(const std::string &address, simulation::Actor actor);
+
+        /**
+         * Plays games and sends their transitions, the latest weights are requested from the server before the first
+         * and after every game. Throws a std::runtime_error if the connection fails.
+         * @param seed seed of the first game, game i uses seed + i
+         * @param stopping run returns after the current game once this is set
+         */
+        void run(std::uint64_t seed, const std::atomic<bool> &stopping);
+
+    private:
+        Socket socket;
+        simulation::Actor actor;
+    };
+
+    /**
+     * Plays games on actorCount connections until one of them fails
+     * @param address unix:<path> or tcp:<host>:<port>
+     * @param actorCount number of threads playing games, each with a connection of its own
+     * @param seed thread i plays the games seed + (i << 32) + j
+     * @param actor
+     */
+    void runActors(const std::string &address, std::size_t actorCount, std::uint64_t seed,
+                   const simulation::Actor &actor);
+}
+
+#endif //KITRAINING_ACTORCLIENT_H
@@ -0,0 +1,119 @@
+#include "LearnerServer.h"
+#include "Protocol.h"
+
+namespace distributed {
+    constexpr int POLL_INTERVAL_MS = 10;
+
+    LearnerServer::LearnerServer(const std::string &address, double learningRate, double discountRate,
+                                 communication::Nets nets, simulation::LearnerOptions options,
+                                 communication::TargetNets targetNets) : serverSocket(address),
+                                 learner(learningRate, discountRate, std::move(nets), options, std::move(targetNets)),
+                                 acceptThread(&LearnerServer::accept, this) {}
+
+    LearnerServer::~LearnerServer() {
+        stopping = true;
+        acceptThread.join();
+        for(auto &connection : connections){
+            connection.thread.join();
+        }
+    }
+
+    auto LearnerServer::collectGames() -> std::vector<communication::GameStatistics> {
+        std::unique_lock<std::mutex> lock{gamesMutex};
+        gameFinished.wait(lock, [this]{ return !finishedGames.empty(); });
+        std::vector<communication::GameStatistics> games;
+        games.swap(finishedGames);
+        return games;
+    }
+
+    auto LearnerServer::getPublishedNets() const -> std::shared_ptr<const communication::FrozenNets> {
+        return learner.getPublishedNets();
+    }
+
+    auto LearnerServer::getStatistics() const -> simulation::LearnerStatistics {
+        return learner.getStatistics();
+    }
+
+    void LearnerServer::accept() {
+        while(!stopping){
+            auto socket = serverSocket.accept(POLL_INTERVAL_MS);
+            if(socket.has_value()){
+                auto &connection = connections.emplace_back();
+                connection.thread = std::thread{[this, &connection](Socket socket){
+                    serve(std::move(socket));
+                    connection.finished = true;
+                }, std::move(*socket)};
+            }
+
+            for(auto it = connections.begin(); it != connections.end();){
+                if(it->finished){
+                    it->thread.join();
+                    it = connections.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    void LearnerServer::serve(Socket socket) {
+        try {
+            while(!socket.readable(POLL_INTERVAL_MS)){
+                if(stopping){
+                    return;
+                }
+            }
+
+            auto hello = receiveMessage(socket);
+            if(hello.type != MessageType::Hello){
+                return;
+            }
+
+            checkHello(hello.payload);
+            std::shared_ptr<const communication::FrozenNets> sentNets;
+            while(!stopping){
+                if(!socket.readable(POLL_INTERVAL_MS)){
+                    continue;
+                }
+
+                auto message = receiveMessage(socket);
+                if(message.type == MessageType::Transitions){
+                    for(auto &transition : decodeTransitions(message.payload)){
+                        learner.push(std::move(transition));
+                    }
+                } else if(message.type == MessageType::GameFinished){
+                    {
+                        std::lock_guard<std::mutex> lock{gamesMutex};
+                        finishedGames.emplace_back(decodeGame(message.payload));
+                    }
+
+                    gameFinished.notify_one();
+                } else if(message.type == MessageType::WeightsRequest){
+                    // Publications between two requests are skipped, the actor only plays with the latest one
+                    auto publishedNets = learner.getPublishedNets();
+                    if(publishedNets == sentNets){
+                        sendMessage(socket, MessageType::WeightsUnchanged, {});
+                    } else {
+                        sendMessage(socket, MessageType::Weights, *weightsPayload(publishedNets));
+                        sentNets = publishedNets;
+                    }
+                } else {
+                    return;
+                }
+            }
+        } catch (std::exception &) {
+            // The actor disconnected or sent an invalid message, the other actors are not affected
+        }
+    }
+
+    auto LearnerServer::weightsPayload(const std::shared_ptr<const communication::FrozenNets> &nets) ->
+        std::shared_ptr<const std::vector<std::uint8_t>> {
+        std::lock_guard<std::mutex> lock{weightsMutex};
+        if(nets != encodedNets){
+            encodedWeights = std::make_shared<const std::vector<std::uint8_t>>(encodeWeights(*nets));
+            encodedNets = nets;
+        }
+
+        return encodedWeights;
+    }
+}
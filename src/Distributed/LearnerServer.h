@@ -0,0 +1,85 @@
+#ifndef KITRAINING_LEARNERSERVER_H
+#define KITRAINING_LEARNERSERVER_H
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <Simulation/AsyncTrainer.h>
+#include "Socket.h"
+
+namespace distributed {
+    /**
+     * Trains with games played by actor processes connected over sockets. Every connection is served by a thread of
+     * its own which pushes the received transitions to the Learner and answers the weight requests of the actor with
+     * the latest publication. Actors may connect and disconnect at any time.
+     */
+    class LearnerServer : public simulation::AsyncTrainer {
+    public:
+        /**
+         * Constructor, starts listening and the learner thread
+         * @param address unix:<path> or tcp:<host>:<port>
+         * @param learningRate
+         * @param discountRate
+         * @param nets the networks trained by the learner, must not be used by any other thread until the
+         * LearnerServer is destroyed
+         * @param options
+         * @param targetNets target networks used by the learner, may be nullptr
+         */
+        LearnerServer(const std::string &address, double learningRate, double discountRate, communication::Nets nets,
+                      simulation::LearnerOptions options, communication::TargetNets targetNets = {});
+
+        /**
+         * Destructor, closes all connections and joins all threads
+         */
+        ~LearnerServer() override;
+
+        auto collectGames() -> std::vector<communication::GameStatistics> override;
+        auto getPublishedNets() const -> std::shared_ptr<const communication::FrozenNets> override;
+        auto getStatistics() const -> simulation::LearnerStatistics override;
+
+    private:
+        ServerSocket serverSocket;
+        simulation::Learner learner;
+        std::atomic<bool> stopping{false};
+
+        std::mutex gamesMutex;
+        std::condition_variable gameFinished;
+        std::vector<communication::GameStatistics> finishedGames;
+
+        std::mutex weightsMutex;
+        std::shared_ptr<const communication::FrozenNets> encodedNets; ///< The publication encoded in encodedWeights
+        std::shared_ptr<const std::vector<std::uint8_t>> encodedWeights;
+
+        /**
+         * Thread serving one actor
+         */
+        struct Connection {
+            std::atomic<bool> finished{false}; ///< Set by the thread before it returns
+            std::thread thread;
+        };
+
+        std::list<Connection> connections; ///< Only accessed by the accept thread
+        std::thread acceptThread;
+
+        /**
+         * Main loop of the accept thread, joins the threads of closed connections
+         */
+        void accept();
+
+        /**
+         * Main loop of a connection thread, returns when the actor disconnects
+         * @param socket
+         */
+        void serve(Socket socket);
+
+        /**
+         * Encodes every publication only once for all connections
+         * @param nets
+         * @return the Weights payload of nets
+         */
+        auto weightsPayload(const std::shared_ptr<const communication::FrozenNets> &nets) ->
+            std::shared_ptr<const std::vector<std::uint8_t>>;
+    };
+}
+
+#endif //KITRAINING_LEARNERSERVER_H
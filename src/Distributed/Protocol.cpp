@@ -0,0 +1,276 @@
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+#include <AI/NetFile.h>
+#include "Protocol.h"
+
+namespace distributed {
+    namespace {
+        /**
+         * The Mlp can only be serialized to files, every call gets a file of its own
+         */
+        auto temporaryFile() -> std::filesystem::path {
+            static std::atomic<std::uint64_t> counter{0};
+            return std::filesystem::temp_directory_path() /
+                ("kitraining_" + std::to_string(getpid()) + "_" + std::to_string(counter++) + ".json");
+        }
+
+        auto serialize(const ai::StateEstimator &net) -> std::string {
+            auto path = temporaryFile();
+            ai::saveNet(path.string(), net);
+            std::ifstream file{path};
+            std::stringstream content;
+            content << file.rdbuf();
+            std::filesystem::remove(path);
+            return content.str();
+        }
+
+        auto deserialize(const std::string &json) -> std::shared_ptr<const ai::StateEstimator> {
+            auto path = temporaryFile();
+            {
+                std::ofstream file{path};
+                file << json;
+            }
+
+            auto net = std::make_shared<const ai::StateEstimator>(ai::loadNet(path.string()));
+            std::filesystem::remove(path);
+            return net;
+        }
+
+        void writeFeatures(Writer &writer, const ai::FeatureVec &features) {
+            for(auto feature : features){
+                writer.f32(static_cast<float>(feature));
+            }
+        }
+
+        auto readFeatures(Reader &reader) -> ai::FeatureVec {
+            ai::FeatureVec features{};
+            for(auto &feature : features){
+                feature = reader.f32();
+            }
+
+            return features;
+        }
+    }
+
+    void Writer::u8(std::uint8_t value) {
+        data.emplace_back(value);
+    }
+
+    void Writer::u32(std::uint32_t value) {
+        for(int i = 0; i < 4; i++){
+            data.emplace_back(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void Writer::u64(std::uint64_t value) {
+        for(int i = 0; i < 8; i++){
+            data.emplace_back(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void Writer::f32(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    void Writer::f64(double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u64(bits);
+    }
+
+    void Writer::bytes(const std::string &value) {
+        u32(static_cast<std::uint32_t>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    auto Writer::finish() -> std::vector<std::uint8_t> {
+        return std::move(data);
+    }
+
+    Reader::Reader(const std::vector<std::uint8_t> &data) : data(data) {}
+
+    void Reader::require(std::size_t size) const {
+        if(data.size() - position < size){
+            throw std::runtime_error("Message too short");
+        }
+    }
+
+    auto Reader::u8() -> std::uint8_t {
+        require(1);
+        return data[position++];
+    }
+
+    auto Reader::u32() -> std::uint32_t {
+        require(4);
+        std::uint32_t value = 0;
+        for(int i = 0; i < 4; i++){
+            value |= static_cast<std::uint32_t>(data[position++]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    auto Reader::u64() -> std::uint64_t {
+        require(8);
+        std::uint64_t value = 0;
+        for(int i = 0; i < 8; i++){
+            value |= static_cast<std::uint64_t>(data[position++]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    auto Reader::f32() -> float {
+        auto bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    auto Reader::f64() -> double {
+        auto bits = u64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    auto Reader::bytes() -> std::string {
+        auto size = u32();
+        require(size);
+        std::string value{data.begin() + position, data.begin() + position + size};
+        position += size;
+        return value;
+    }
+
+    void Reader::finish() const {
+        if(position != data.size()){
+            throw std::runtime_error("Message too long");
+        }
+    }
+
+    void sendMessage(Socket &socket, MessageType type, const std::vector<std::uint8_t> &payload) {
+        Writer header;
+        header.u8(static_cast<std::uint8_t>(type));
+        header.u32(static_cast<std::uint32_t>(payload.size()));
+        auto message = header.finish();
+        message.insert(message.end(), payload.begin(), payload.end());
+        socket.sendAll(message);
+    }
+
+    auto receiveMessage(Socket &socket) -> Message {
+        auto headerData = socket.receiveAll(5);
+        Reader header{headerData};
+        auto type = header.u8();
+        auto size = header.u32();
+        if(type > static_cast<std::uint8_t>(MessageType::WeightsUnchanged)){
+            throw std::runtime_error("Unknown message type " + std::to_string(type));
+        } else if(size > MAX_PAYLOAD_SIZE){
+            throw std::runtime_error("Message too large: " + std::to_string(size) + " bytes");
+        }
+
+        return {static_cast<MessageType>(type), socket.receiveAll(size)};
+    }
+
+    auto encodeHello() -> std::vector<std::uint8_t> {
+        Writer writer;
+        writer.u32(PROTOCOL_VERSION);
+        return writer.finish();
+    }
+
+    void checkHello(const std::vector<std::uint8_t> &payload) {
+        Reader reader{payload};
+        auto version = reader.u32();
+        reader.finish();
+        if(version != PROTOCOL_VERSION){
+            throw std::runtime_error("Protocol version " + std::to_string(version) + " is not supported");
+        }
+    }
+
+    auto encodeTransitions(const std::vector<ai::Transition> &transitions) -> std::vector<std::uint8_t> {
+        Writer writer;
+        writer.u32(static_cast<std::uint32_t>(transitions.size()));
+        for(const auto &transition : transitions){
+            writer.u8(transition.side == gameModel::TeamSide::LEFT ? 0 : 1);
+            writer.f64(transition.reward);
+            writeFeatures(writer, transition.features);
+            writeFeatures(writer, transition.next);
+        }
+
+        return writer.finish();
+    }
+
+    auto decodeTransitions(const std::vector<std::uint8_t> &payload) -> std::vector<ai::Transition> {
+        Reader reader{payload};
+        auto count = reader.u32();
+        std::vector<ai::Transition> transitions;
+        transitions.reserve(std::min<std::size_t>(count, payload.size()));
+        for(std::uint32_t i = 0; i < count; i++){
+            ai::Transition transition;
+            transition.side = reader.u8() == 0 ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT;
+            transition.reward = reader.f64();
+            transition.features = readFeatures(reader);
+            transition.next = readFeatures(reader);
+            transitions.emplace_back(std::move(transition));
+        }
+
+        reader.finish();
+        return transitions;
+    }
+
+    auto encodeGame(const communication::GameStatistics &game) -> std::vector<std::uint8_t> {
+        Writer writer;
+        writer.u64(game.steps);
+        writer.u64(game.decisions);
+        writer.u32(static_cast<std::uint32_t>(game.rounds));
+        writer.u8(game.result.has_value());
+        if(game.result.has_value()){
+            writer.u8(game.result->first == gameModel::TeamSide::LEFT ? 0 : 1);
+            writer.u8(static_cast<std::uint8_t>(game.result->second));
+        }
+
+        return writer.finish();
+    }
+
+    auto decodeGame(const std::vector<std::uint8_t> &payload) -> communication::GameStatistics {
+        Reader reader{payload};
+        communication::GameStatistics game;
+        game.steps = reader.u64();
+        game.decisions = reader.u64();
+        game.rounds = static_cast<int>(reader.u32());
+        if(reader.u8()){
+            auto winner = reader.u8() == 0 ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT;
+            game.result.emplace(winner, static_cast<communication::messages::types::VictoryReason>(reader.u8()));
+        }
+
+        reader.finish();
+        return game;
+    }
+
+    auto encodeWeights(const communication::FrozenNets &nets) -> std::vector<std::uint8_t> {
+        Writer writer;
+        bool shared = nets.first == nets.second;
+        writer.u8(shared);
+        writer.bytes(serialize(*nets.first));
+        if(!shared){
+            writer.bytes(serialize(*nets.second));
+        }
+
+        return writer.finish();
+    }
+
+    auto decodeWeights(const std::vector<std::uint8_t> &payload) -> communication::FrozenNets {
+        Reader reader{payload};
+        auto shared = reader.u8();
+        auto left = deserialize(reader.bytes());
+        auto right = shared ? left : deserialize(reader.bytes());
+        reader.finish();
+        return {left, right};
+    }
+}
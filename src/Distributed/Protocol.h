@@ -0,0 +1,121 @@
+#ifndef KITRAINING_PROTOCOL_H
+#define KITRAINING_PROTOCOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <Communication/Communicator.h>
+#include "Socket.h"
+
+/**
+ * Messages between the learner process and the actor processes. Every message is a one byte type and a four byte
+ * payload length followed by the payload, all numbers are little endian.
+ */
+namespace distributed {
+    constexpr std::uint32_t PROTOCOL_VERSION = 1;
+    constexpr std::uint32_t MAX_PAYLOAD_SIZE = 1u << 28u;
+
+    /**
+     * The learner only sends in response to a WeightsRequest, which the actor sends between games and then waits for
+     * the response. So the learner never writes while the actor is sending transitions and neither side can block the
+     * other with full socket buffers.
+     */
+    enum class MessageType : std::uint8_t {
+        Hello, ///< Actor to learner, first message of a connection
+        Transitions, ///< Actor to learner
+        GameFinished, ///< Actor to learner, after the transitions of the game
+        WeightsRequest, ///< Actor to learner, after the hello and after every game
+        Weights, ///< Learner to actor, the latest publication
+        WeightsUnchanged ///< Learner to actor, there was no publication since the last Weights of this connection
+    };
+
+    struct Message {
+        MessageType type;
+        std::vector<std::uint8_t> payload;
+    };
+
+    /**
+     * Appends little endian values to a payload
+     */
+    class Writer {
+    public:
+        void u8(std::uint8_t value);
+        void u32(std::uint32_t value);
+        void u64(std::uint64_t value);
+        void f32(float value);
+        void f64(double value);
+        void bytes(const std::string &value);
+        auto finish() -> std::vector<std::uint8_t>;
+
+    private:
+        std::vector<std::uint8_t> data;
+    };
+
+    /**
+     * Reads little endian values from a payload, throws a std::runtime_error when reading past its end
+     */
+    class Reader {
+    public:
+        explicit Reader(const std::vector<std::uint8_t> &data);
+        auto u8() -> std::uint8_t;
+        auto u32() -> std::uint32_t;
+        auto u64() -> std::uint64_t;
+        auto f32() -> float;
+        auto f64() -> double;
+        auto bytes() -> std::string;
+
+        /**
+         * Throws if the payload has unread bytes
+         */
+        void finish() const;
+
+    private:
+        const std::vector<std::uint8_t> &data;
+        std::size_t position = 0;
+
+        void require(std::size_t size) const;
+    };
+
+    void sendMessage(Socket &socket, MessageType type, const std::vector<std::uint8_t> &payload);
+
+    /**
+     * Blocks until a complete message arrived
+     * @param socket
+     * @return
+     */
+    auto receiveMessage(Socket &socket) -> Message;
+
+    auto encodeHello() -> std::vector<std::uint8_t>;
+
+    /**
+     * Throws if the version of the other side differs
+     * @param payload
+     */
+    void checkHello(const std::vector<std::uint8_t> &payload);
+
+    /**
+     * The features are small integers and sent as float, the rewards are sent unchanged
+     * @param transitions
+     * @return
+     */
+    auto encodeTransitions(const std::vector<ai::Transition> &transitions) -> std::vector<std::uint8_t>;
+    auto decodeTransitions(const std::vector<std::uint8_t> &payload) -> std::vector<ai::Transition>;
+
+    /**
+     * Only the game result is sent, the actors do not train
+     * @param game
+     * @return
+     */
+    auto encodeGame(const communication::GameStatistics &game) -> std::vector<std::uint8_t>;
+    auto decodeGame(const std::vector<std::uint8_t> &payload) -> communication::GameStatistics;
+
+    /**
+     * The networks are sent in the json format of ai::saveNet, a shared network only once
+     * @param nets
+     * @return
+     */
+    auto encodeWeights(const communication::FrozenNets &nets) -> std::vector<std::uint8_t>;
+    auto decodeWeights(const std::vector<std::uint8_t> &payload) -> communication::FrozenNets;
+}
+
+#endif //KITRAINING_PROTOCOL_H
@@ -0,0 +1,221 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Socket.h"
+
+namespace distributed {
+    namespace {
+        auto systemError(const std::string &what) -> std::runtime_error {
+            return std::runtime_error(what + ": " + std::strerror(errno));
+        }
+
+        /**
+         * Address of a Unix domain socket
+         */
+        auto unixAddress(const std::string &path) -> sockaddr_un {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if(path.size() >= sizeof(address.sun_path)){
+                throw std::runtime_error("Socket path too long: " + path);
+            }
+
+            std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            return address;
+        }
+
+        /**
+         * Resolves host and port of a tcp:<host>:<port> address
+         */
+        auto resolve(const std::string &address, bool passive) -> addrinfo * {
+            auto separator = address.rfind(':');
+            if(separator == std::string::npos || separator < 4){
+                throw std::runtime_error("Invalid address " + address + ", expected tcp:<host>:<port>");
+            }
+
+            auto host = address.substr(4, separator - 4);
+            auto port = address.substr(separator + 1);
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_flags = passive ? AI_PASSIVE : 0;
+            addrinfo *result = nullptr;
+            auto error = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+            if(error != 0){
+                throw std::runtime_error("Could not resolve " + address + ": " + gai_strerror(error));
+            }
+
+            return result;
+        }
+
+        bool isUnix(const std::string &address) {
+            return address.rfind("unix:", 0) == 0;
+        }
+
+        bool isTcp(const std::string &address) {
+            return address.rfind("tcp:", 0) == 0;
+        }
+
+        /**
+         * Waits for one event on a file descriptor
+         */
+        bool waitFor(int fd, short events, int timeoutMs) {
+            pollfd request{fd, events, 0};
+            auto ready = poll(&request, 1, timeoutMs);
+            if(ready < 0 && errno != EINTR){
+                throw systemError("poll failed");
+            }
+
+            return ready > 0;
+        }
+    }
+
+    Socket::Socket(int fd) : fd(fd) {}
+
+    Socket::~Socket() {
+        if(fd >= 0){
+            close(fd);
+        }
+    }
+
+    Socket::Socket(Socket &&other) noexcept : fd(other.fd) {
+        other.fd = -1;
+    }
+
+    auto Socket::operator=(Socket &&other) noexcept -> Socket & {
+        std::swap(fd, other.fd);
+        return *this;
+    }
+
+    auto Socket::connect(const std::string &address) -> Socket {
+        if(isUnix(address)){
+            auto local = unixAddress(address.substr(5));
+            Socket socket{::socket(AF_UNIX, SOCK_STREAM, 0)};
+            if(socket.fd < 0 || ::connect(socket.fd, reinterpret_cast<sockaddr *>(&local), sizeof(local)) != 0){
+                throw systemError("Could not connect to " + address);
+            }
+
+            return socket;
+        } else if(!isTcp(address)){
+            throw std::runtime_error("Invalid address " + address + ", expected unix:<path> or tcp:<host>:<port>");
+        }
+
+        auto addresses = resolve(address, false);
+        for(auto *candidate = addresses; candidate != nullptr; candidate = candidate->ai_next){
+            Socket socket{::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol)};
+            if(socket.fd >= 0 && ::connect(socket.fd, candidate->ai_addr, candidate->ai_addrlen) == 0){
+                freeaddrinfo(addresses);
+                // Transitions are sent in batches, waiting for more data only adds latency
+                int noDelay = 1;
+                setsockopt(socket.fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                return socket;
+            }
+        }
+
+        freeaddrinfo(addresses);
+        throw systemError("Could not connect to " + address);
+    }
+
+    void Socket::sendAll(const std::vector<std::uint8_t> &data) {
+        std::size_t sent = 0;
+        while(sent < data.size()){
+            auto result = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if(result < 0){
+                if(errno == EINTR){
+                    continue;
+                }
+
+                throw systemError("send failed");
+            }
+
+            sent += static_cast<std::size_t>(result);
+        }
+    }
+
+    auto Socket::receiveAll(std::size_t size) -> std::vector<std::uint8_t> {
+        std::vector<std::uint8_t> data(size);
+        std::size_t received = 0;
+        while(received < size){
+            auto result = recv(fd, data.data() + received, size - received, 0);
+            if(result == 0){
+                throw std::runtime_error("Connection closed");
+            } else if(result < 0){
+                if(errno == EINTR){
+                    continue;
+                }
+
+                throw systemError("recv failed");
+            }
+
+            received += static_cast<std::size_t>(result);
+        }
+
+        return data;
+    }
+
+    bool Socket::readable(int timeoutMs) {
+        return waitFor(fd, POLLIN, timeoutMs);
+    }
+
+    ServerSocket::ServerSocket(const std::string &address) : fd(-1) {
+        if(isUnix(address)){
+            unixPath = address.substr(5);
+            auto local = unixAddress(unixPath);
+            unlink(unixPath.c_str());
+            fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if(fd < 0 || bind(fd, reinterpret_cast<sockaddr *>(&local), sizeof(local)) != 0){
+                throw systemError("Could not bind " + address);
+            }
+        } else if(isTcp(address)){
+            auto addresses = resolve(address, true);
+            for(auto *candidate = addresses; candidate != nullptr && fd < 0; candidate = candidate->ai_next){
+                fd = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+                int reuse = 1;
+                if(fd >= 0 && (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+                    bind(fd, candidate->ai_addr, candidate->ai_addrlen) != 0)){
+                    close(fd);
+                    fd = -1;
+                }
+            }
+
+            freeaddrinfo(addresses);
+            if(fd < 0){
+                throw systemError("Could not bind " + address);
+            }
+        } else {
+            throw std::runtime_error("Invalid address " + address + ", expected unix:<path> or tcp:<host>:<port>");
+        }
+
+        if(listen(fd, SOMAXCONN) != 0){
+            throw systemError("Could not listen on " + address);
+        }
+    }
+
+    ServerSocket::~ServerSocket() {
+        close(fd);
+        if(!unixPath.empty()){
+            unlink(unixPath.c_str());
+        }
+    }
+
+    auto ServerSocket::accept(int timeoutMs) -> std::optional<Socket> {
+        if(!waitFor(fd, POLLIN, timeoutMs)){
+            return std::nullopt;
+        }
+
+        auto connection = ::accept(fd, nullptr, nullptr);
+        if(connection < 0){
+            return std::nullopt;
+        }
+
+        int noDelay = 1;
+        setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        return Socket{connection};
+    }
+}
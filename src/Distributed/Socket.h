@@ -0,0 +1,89 @@
+#ifndef KITRAINING_SOCKET_H
+#define KITRAINING_SOCKET_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace distributed {
+    /**
+     * Connected stream socket (TCP or Unix domain), closed on destruction. All functions throw a std::runtime_error
+     * if the connection fails.
+     */
+    class Socket {
+    public:
+        /**
+         * Takes ownership of a connected file descriptor
+         * @param fd
+         */
+        explicit Socket(int fd);
+
+        ~Socket();
+
+        Socket(Socket &&other) noexcept;
+        auto operator=(Socket &&other) noexcept -> Socket &;
+        Socket(const Socket &) = delete;
+        auto operator=(const Socket &) -> Socket & = delete;
+
+        /**
+         * Connects to a listening socket
+         * @param address unix:<path> or tcp:<host>:<port>
+         * @return
+         */
+        static auto connect(const std::string &address) -> Socket;
+
+        /**
+         * Sends all bytes, blocks until they are handed to the operating system
+         * @param data
+         */
+        void sendAll(const std::vector<std::uint8_t> &data);
+
+        /**
+         * Receives exactly size bytes, blocks until they arrived
+         * @param size
+         * @return
+         */
+        auto receiveAll(std::size_t size) -> std::vector<std::uint8_t>;
+
+        /**
+         * Waits until data can be received
+         * @param timeoutMs maximum time to wait, 0 returns immediately
+         * @return true if data can be received or the connection was closed by the other side
+         */
+        bool readable(int timeoutMs);
+
+    private:
+        int fd;
+    };
+
+    /**
+     * Listening stream socket, closed on destruction
+     */
+    class ServerSocket {
+    public:
+        /**
+         * Binds and listens
+         * @param address unix:<path> or tcp:<host>:<port>, use 0.0.0.0 as host to accept connections from all hosts
+         */
+        explicit ServerSocket(const std::string &address);
+
+        ~ServerSocket();
+
+        ServerSocket(const ServerSocket &) = delete;
+        auto operator=(const ServerSocket &) -> ServerSocket & = delete;
+
+        /**
+         * Waits for a connection
+         * @param timeoutMs maximum time to wait
+         * @return the connection, nullopt if there was none within the timeout
+         */
+        auto accept(int timeoutMs) -> std::optional<Socket>;
+
+    private:
+        int fd;
+        std::string unixPath; ///< Path of a Unix domain socket, removed on destruction
+    };
+}
+
+#endif //KITRAINING_SOCKET_H
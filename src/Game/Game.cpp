@@ -8,22 +8,24 @@
 #include <SopraGameLogic/GameModel.h>
 #include <SopraGameLogic/conversions.h>
 #include <AI/AI.h>
+#include <Profiling/PhaseTimer.h>
+#include <Profiling/Tracer.h>
 #include <fstream>
 
 namespace gameHandling{
     Game::Game(communication::messages::broadcast::MatchConfig matchConfig, const communication::messages::request::TeamConfig& teamConfig1,
             const communication::messages::request::TeamConfig& teamConfig2, communication::messages::request::TeamFormation teamFormation1,
-               communication::messages::request::TeamFormation teamFormation2, util::Logging &log, std::string expDir) : environment(std::make_shared<gameModel::Environment>
-                       (matchConfig, teamConfig1, teamConfig2, teamFormation1, teamFormation2)),
-                       timeouts{matchConfig.getPlayerTurnTimeout(), matchConfig.getFanTurnTimeout(), matchConfig.getUnbanTurnTimeout()},
-                       phaseManager(environment->team1, environment->team2, environment, timeouts), log(log), experienceDirectory(std::move(expDir)){
+               communication::messages::request::TeamFormation teamFormation2, util::Logging &log, std::string expDir, std::uint64_t seed) :
+                       environment(std::make_shared<gameModel::Environment>(matchConfig, teamConfig1, teamConfig2, teamFormation1, teamFormation2)),
+                       timeouts{matchConfig.getPlayerTurnTimeout(), matchConfig.getFanTurnTimeout(), matchConfig.getUnbanTurnTimeout()}, rng(seed),
+                       phaseManager(environment->team1, environment->team2, environment, timeouts, rng), log(log), experienceDirectory(std::move(expDir)){
         log.debug("Constructed game");
     }
 
-    Game::Game(communication::messages::broadcast::MatchConfig matchConfig, const aiTools::State &state, util::Logging &log, std::string expDir) :
-        environment(state.env), currentPhase(state.currentPhase), roundNumber(state.roundNumber),
-        timeouts{matchConfig.getPlayerTurnTimeout(), matchConfig.getFanTurnTimeout(), matchConfig.getUnbanTurnTimeout()},
-        phaseManager(environment->team1, environment->team2, environment, timeouts), overTimeState(state.overtimeState),
+    Game::Game(communication::messages::broadcast::MatchConfig matchConfig, const aiTools::State &state, util::Logging &log, std::string expDir,
+            std::uint64_t seed) : environment(state.env), currentPhase(state.currentPhase), roundNumber(state.roundNumber),
+        timeouts{matchConfig.getPlayerTurnTimeout(), matchConfig.getFanTurnTimeout(), matchConfig.getUnbanTurnTimeout()}, rng(seed),
+        phaseManager(environment->team1, environment->team2, environment, timeouts, rng), overTimeState(state.overtimeState),
         overTimeCounter(state.overTimeCounter), goalScored(state.goalScoredThisRound), log(log), experienceDirectory(std::move(expDir)){
         for(const auto &player : environment->getAllPlayers()){
             if(player->isFined){
@@ -33,7 +35,7 @@ namespace gameHandling{
 
         if(environment->team1->numberOfBannedMembers() > MAX_BAN_COUNT &&
             environment->team2->numberOfBannedMembers() > MAX_BAN_COUNT) {
-            if(gameController::rng(0, 1)){
+            if(rng(0, 1)){
                 firstSideDisqualified.emplace(gameModel::TeamSide::LEFT);
             } else {
                 firstSideDisqualified.emplace(gameModel::TeamSide::RIGHT);
@@ -138,6 +140,8 @@ namespace gameHandling{
     }
 
     bool Game::executeDelta(communication::messages::request::DeltaRequest command, gameModel::TeamSide side) {
+        KITRAINING_TRACE_SCOPE("Game::executeDelta");
+        std::lock_guard<std::mutex> lock(gameLogicMutex());
         using namespace communication::messages::types;
         auto addFouls = [this](const std::vector<gameModel::Foul> &fouls, const std::shared_ptr<gameModel::Player> &player){
             if(!fouls.empty()){
@@ -190,7 +194,7 @@ namespace gameHandling{
 
                         auto res = bShot.execute();
                         addFouls(res.second, player);
-                        getUsedPlayers(side).emplace(player->getId());
+                        getUsedPlayers(side) |= playerBit(player->getId());
                         return true;
                     } catch (std::exception &e){
                         throw std::runtime_error(e.what());
@@ -235,7 +239,7 @@ namespace gameHandling{
                             }
                         }
 
-                        getUsedPlayers(side).emplace(player->getId());
+                        getUsedPlayers(side) |= playerBit(player->getId());
                         return true;
                     } catch (std::exception &e){
                         throw std::runtime_error(e.what());
@@ -422,7 +426,7 @@ namespace gameHandling{
                         }
 
                         if(phaseManager.playerUsed(player)){
-                            getUsedPlayers(side).emplace(player->getId());
+                            getUsedPlayers(side) |= playerBit(player->getId());
                         }
 
                         if(snitchCaught){
@@ -554,6 +558,8 @@ namespace gameHandling{
     }
 
     void Game::executeBallDelta(communication::messages::types::EntityId entityId){
+        KITRAINING_PROFILE_PHASE(profiling::Phase::BallTurn);
+        std::lock_guard<std::mutex> lock(gameLogicMutex());
         std::shared_ptr<gameModel::Ball> ball;
         using namespace communication::messages::types;
 
@@ -603,6 +609,7 @@ namespace gameHandling{
 
     void Game::changePhase() {
         log.debug("Phase over");
+        std::lock_guard<std::mutex> lock(gameLogicMutex());
         gameController::moveQuaffelAfterGoal(environment);
 
     }
@@ -615,8 +622,8 @@ namespace gameHandling{
         roundNumber++;
         phaseManager.reset();
         environment->removeDeprecatedShit();
-        playersUsedRight.clear();
-        playersUsedLeft.clear();
+        playersUsedRight = 0;
+        playersUsedLeft = 0;
 
         if(environment->team1->numberOfBannedMembers() > MAX_BAN_COUNT &&
             environment->team2->numberOfBannedMembers() > MAX_BAN_COUNT) {
@@ -640,6 +647,7 @@ namespace gameHandling{
         }
 
         if(roundNumber == SNITCH_SPAWN_ROUND){
+            std::lock_guard<std::mutex> lock(gameLogicMutex());
             gameController::spawnSnitch(environment);
         }
 
@@ -684,6 +692,7 @@ namespace gameHandling{
     }
 
     auto Game::getState() const -> aiTools::State{
+        KITRAINING_PROFILE_PHASE(profiling::Phase::GetState);
         using Ftype = communication::messages::types::FanType;
         std::array<unsigned int, 5> availableFansLeft = {};
         std::array<unsigned int, 5> availableFansRight = {};
@@ -699,11 +708,10 @@ namespace gameHandling{
         availableFansRight[3] = environment->getTeam(gameModel::TeamSide::RIGHT)->fanblock.getUses(Ftype::NIFFLER) - phaseManager.interferencesUsedRight(Ftype::NIFFLER);
         availableFansRight[4] = environment->getTeam(gameModel::TeamSide::RIGHT)->fanblock.getUses(Ftype::WOMBAT) - phaseManager.interferencesUsedRight(Ftype::WOMBAT);
 
-        return {environment->clone(), roundNumber, currentPhase, overTimeState, overTimeCounter, goalScored, playersUsedLeft, playersUsedRight, availableFansLeft, availableFansRight};
+        return {environment->clone(), roundNumber, currentPhase, overTimeState, overTimeCounter, goalScored, toPlayerSet(playersUsedLeft), toPlayerSet(playersUsedRight), availableFansLeft, availableFansRight};
     }
 
-    auto Game::getUsedPlayers(const gameModel::TeamSide &side) ->
-        std::unordered_set<communication::messages::types::EntityId> & {
+    auto Game::getUsedPlayers(const gameModel::TeamSide &side) -> PlayerMask & {
         return side == gameModel::TeamSide::LEFT ? playersUsedLeft : playersUsedRight;
     }
 
@@ -729,9 +737,8 @@ namespace gameHandling{
         auto snitchExists = currentState.env->snitch->exists && ballTurn == EntityId::BLUDGER1 &&
                 currentState.currentPhase == PhaseType::BALL_PHASE;
 
-        auto notUsed = [&currentState](const std::shared_ptr<gameModel::Player> &p){
-            return currentState.playersUsedLeft.find(p->getId()) == currentState.playersUsedLeft.end() &&
-                currentState.playersUsedRight.find(p->getId()) == currentState.playersUsedRight.end();
+        auto notUsed = [this](const std::shared_ptr<gameModel::Player> &p){
+            return !containsPlayer(static_cast<PlayerMask>(playersUsedLeft | playersUsedRight), p->getId());
         };
 
         auto qThrowPossible = playerOnQuaffle.has_value() && !(*playerOnQuaffle)->knockedOut && notUsed(*playerOnQuaffle);
@@ -17,7 +17,7 @@
 #include "GameTypes.h"
 #include <SopraUtil/Timer.h>
 #include "PhaseManager.h"
-#include <unordered_set>
+#include "Rng.h"
 #include <AI/AI.h>
 
 namespace gameHandling {
@@ -34,15 +34,20 @@ namespace gameHandling {
              const communication::messages::request::TeamConfig& teamConfig2,
              communication::messages::request::TeamFormation teamFormation1,
              communication::messages::request::TeamFormation teamFormation2,
-             util::Logging &log, std::string expDir);
+             util::Logging &log, std::string expDir, std::uint64_t seed);
 
         /**
          * Constructs a game from a saved experience
          * @param expFile file to load the experience from
          * @param log logging instance
          * @param expPath directory to save the new experiences to
+         * @param seed seed for the random number generator of the game
          */
-        Game(communication::messages::broadcast::MatchConfig matchConfig, const aiTools::State &state, util::Logging &log, std::string expDir);
+        Game(communication::messages::broadcast::MatchConfig matchConfig, const aiTools::State &state, util::Logging &log, std::string expDir,
+                std::uint64_t seed);
+
+        Game(const Game &) = delete;
+        Game &operator=(const Game &) = delete;
 
         mutable std::optional<std::pair<gameModel::TeamSide, communication::messages::types::VictoryReason>> winEvent;
 
@@ -82,6 +87,7 @@ namespace gameHandling {
                 communication::messages::types::EntityId::SNITCH; ///< the Ball to make a move
         unsigned int roundNumber = 1;
         Timeouts timeouts;
+        Rng rng; ///< Random number generator of this game, used by the member selection and side choice
         PhaseManager phaseManager;
         communication::messages::broadcast::Next expectedRequestType{}; ///<Next-object containing information about the next expected request from a client
         gameModel::TeamSide currentSide; ///<Current side to make a move
@@ -90,13 +96,13 @@ namespace gameHandling {
         bool goalScored = false;
         std::deque<std::shared_ptr<gameModel::Player>> bannedPlayers = {};
         std::optional<gameModel::TeamSide> firstSideDisqualified = std::nullopt;
-        std::unordered_set<communication::messages::types::EntityId> playersUsedLeft = {};
-        std::unordered_set<communication::messages::types::EntityId> playersUsedRight = {};
+        PlayerMask playersUsedLeft = 0; ///< Players of the left team that used their turn this round
+        PlayerMask playersUsedRight = 0; ///< Players of the right team that used their turn this round
         util::Logging &log;
         std::string experienceDirectory;
         int expDelay = 0;
 
-        auto getUsedPlayers(const gameModel::TeamSide &side) -> std::unordered_set<communication::messages::types::EntityId>&;
+        auto getUsedPlayers(const gameModel::TeamSide &side) -> PlayerMask&;
 
         /**
          * gets the winning Team and the reason for winning when the snitch has been caught.
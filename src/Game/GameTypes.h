@@ -6,6 +6,10 @@
 #define SERVER_GAMETYPES_H
 
 #include <SopraMessages/types.hpp>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
 
 namespace gameHandling {
     enum class GameState {
@@ -17,6 +21,100 @@ namespace gameHandling {
     struct Timeouts{
         const int playerTurn, fanTurn, unbanTurn;
     };
+
+    /**
+     * The actions of SopraGameLogic draw from one random generator shared by the whole process. Every call which may
+     * draw from it (executing the actions of a step, the ball turns and the fan choice) has to hold this mutex as soon
+     * as games run on more than one thread. The searches only enumerate outcomes and do not need it.
+     * @return
+     */
+    inline auto gameLogicMutex() -> std::mutex & {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    constexpr std::size_t PLAYERS_PER_TEAM = 7;
+    constexpr int PITCH_WIDTH = 17;
+    constexpr int PITCH_HEIGHT = 13;
+
+    /**
+     * Set of players stored as one bit per player id
+     */
+    using PlayerMask = std::uint16_t;
+
+    /**
+     * Maps a player id to its bit in a PlayerMask
+     * @param id
+     * @return mask with only the bit of the given player set
+     * @throws std::runtime_error if id is not a player
+     */
+    constexpr auto playerBit(communication::messages::types::EntityId id) -> PlayerMask {
+        using Id = communication::messages::types::EntityId;
+        unsigned int index = 0;
+        switch (id){
+            case Id::LEFT_SEEKER: index = 0; break;
+            case Id::LEFT_KEEPER: index = 1; break;
+            case Id::LEFT_CHASER1: index = 2; break;
+            case Id::LEFT_CHASER2: index = 3; break;
+            case Id::LEFT_CHASER3: index = 4; break;
+            case Id::LEFT_BEATER1: index = 5; break;
+            case Id::LEFT_BEATER2: index = 6; break;
+            case Id::RIGHT_SEEKER: index = 7; break;
+            case Id::RIGHT_KEEPER: index = 8; break;
+            case Id::RIGHT_CHASER1: index = 9; break;
+            case Id::RIGHT_CHASER2: index = 10; break;
+            case Id::RIGHT_CHASER3: index = 11; break;
+            case Id::RIGHT_BEATER1: index = 12; break;
+            case Id::RIGHT_BEATER2: index = 13; break;
+            default:
+                throw std::runtime_error("Id is no player");
+        }
+
+        return static_cast<PlayerMask>(1u << index);
+    }
+
+    /**
+     * Checks if a player is contained in a mask
+     * @param mask
+     * @param id
+     * @return true if the bit of the player is set
+     */
+    constexpr bool containsPlayer(PlayerMask mask, communication::messages::types::EntityId id) {
+        return (mask & playerBit(id)) != 0;
+    }
+
+    /**
+     * Converts a set of player ids to a mask
+     * @param players
+     * @return
+     */
+    inline auto toPlayerMask(const std::unordered_set<communication::messages::types::EntityId> &players) -> PlayerMask {
+        PlayerMask mask = 0;
+        for(const auto &id : players){
+            mask |= playerBit(id);
+        }
+
+        return mask;
+    }
+
+    /**
+     * Converts a mask to a set of player ids
+     * @param mask
+     * @return
+     */
+    inline auto toPlayerSet(PlayerMask mask) -> std::unordered_set<communication::messages::types::EntityId> {
+        using Id = communication::messages::types::EntityId;
+        std::unordered_set<Id> ret;
+        for(auto id : {Id::LEFT_SEEKER, Id::LEFT_KEEPER, Id::LEFT_CHASER1, Id::LEFT_CHASER2, Id::LEFT_CHASER3,
+                       Id::LEFT_BEATER1, Id::LEFT_BEATER2, Id::RIGHT_SEEKER, Id::RIGHT_KEEPER, Id::RIGHT_CHASER1,
+                       Id::RIGHT_CHASER2, Id::RIGHT_CHASER3, Id::RIGHT_BEATER1, Id::RIGHT_BEATER2}){
+            if(containsPlayer(mask, id)){
+                ret.emplace(id);
+            }
+        }
+
+        return ret;
+    }
 }
 
 #endif //SERVER_GAMETYPES_H
@@ -6,7 +6,20 @@
 #include <SopraGameLogic/GameController.h>
 #include <SopraGameLogic/conversions.h>
 namespace gameHandling{
-    MemberSelector::MemberSelector(const std::shared_ptr<gameModel::Team> &team) : team(team){
+    MemberSelector::MemberSelector(const std::shared_ptr<gameModel::Team> &team, Rng &rng) : team(team), rng(rng){
+        std::size_t i = 0;
+        for(const auto &player : team->getAllPlayers()){
+            if(i >= players.size()){
+                throw std::runtime_error("Team has too many players");
+            }
+
+            players[i++] = player;
+        }
+
+        if(i != players.size()){
+            throw std::runtime_error("Team has too few players");
+        }
+
         resetPlayers();
         resetInterferences();
     }
@@ -16,9 +29,9 @@ namespace gameHandling{
             throw std::runtime_error("No more players left to select");
         }
 
-        auto pos = selectRandom<std::shared_ptr<gameModel::Player>>(playersLeft);
-        auto ret = *pos;
-        playersLeft.erase(pos);
+        auto index = selectRandom(playersLeftCount);
+        auto ret = players[playersLeft[index]];
+        swapRemove(playersLeft, playersLeftCount, index);
         return ret;
     }
 
@@ -27,40 +40,39 @@ namespace gameHandling{
             throw std::runtime_error("No more interferences left to select");
         }
 
-        auto pos = selectRandom<std::pair<gameModel::InterferenceType, int>>(interferencesLeft);
-        auto ret = pos->first;
-        if(--pos->second <= 0){
-            interferencesLeft.erase(pos);
+        auto index = selectRandom(interferencesLeftCount);
+        auto &inter = interferencesLeft[index];
+        auto ret = inter.first;
+        if(--inter.second <= 0){
+            swapRemove(interferencesLeft, interferencesLeftCount, index);
         }
 
         return gameLogic::conversions::interferenceToId(ret, team->getSide());
     }
 
     bool MemberSelector::hasPlayers() const {
-        return !playersLeft.empty();
+        return playersLeftCount > 0;
     }
 
     bool MemberSelector::hasInterference() const {
-        return !interferencesLeft.empty();
+        return interferencesLeftCount > 0;
     }
 
     void MemberSelector::resetPlayers() {
-        playersLeft.clear();
-        for(const auto &player : team->getAllPlayers()){
-            playersLeft.emplace_back(player);
+        for(std::size_t i = 0; i < playersLeft.size(); i++){
+            playersLeft[i] = static_cast<std::uint8_t>(i);
         }
+
+        playersLeftCount = playersLeft.size();
     }
 
     void MemberSelector::resetInterferences() {
         using Id = gameModel::InterferenceType;
-        interferencesLeft = {{Id::Teleport, 0}, {Id::RangedAttack, 0}, {Id::Impulse, 0}, {Id::SnitchPush, 0}, {Id::BlockCell, 0}};
-        for(auto it = interferencesLeft.begin(); it < interferencesLeft.end();){
-            int uses = team->fanblock.getUses(it->first);
-            if(uses == 0){
-                it = interferencesLeft.erase(it);
-            } else {
-                it->second = uses;
-                it++;
+        interferencesLeftCount = 0;
+        for(auto type : {Id::Teleport, Id::RangedAttack, Id::Impulse, Id::SnitchPush, Id::BlockCell}){
+            int uses = team->fanblock.getUses(type);
+            if(uses != 0){
+                interferencesLeft[interferencesLeftCount++] = {type, uses};
             }
         }
     }
@@ -70,8 +82,8 @@ namespace gameHandling{
             throw std::runtime_error("Player not in Team");
         }
 
-        for(const auto &player: playersLeft){
-            if(player->getId() == id){
+        for(std::size_t i = 0; i < playersLeftCount; i++){
+            if(players[playersLeft[i]]->getId() == id){
                 return false;
             }
         }
@@ -85,7 +97,8 @@ namespace gameHandling{
             return 0;
         }
 
-        for(const auto& fan : interferencesLeft){
+        for(std::size_t i = 0; i < interferencesLeftCount; i++){
+            const auto &fan = interferencesLeft[i];
             if(fan.first == gameLogic::conversions::fanToInterference(type)){
                 return team->fanblock.getUses(type) - fan.second;
             }
@@ -97,4 +110,8 @@ namespace gameHandling{
     auto MemberSelector::getSide() const -> gameModel::TeamSide {
         return team->getSide();
     }
+
+    auto MemberSelector::selectRandom(std::size_t count) -> std::size_t {
+        return static_cast<std::size_t>(rng(0, static_cast<int>(count) - 1));
+    }
 }
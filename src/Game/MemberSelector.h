@@ -8,14 +8,23 @@
 #include <SopraMessages/types.hpp>
 #include <SopraGameLogic/GameModel.h>
 #include <SopraGameLogic/GameController.h>
-#include <deque>
+#include <array>
+#include <cstdint>
 #include <SopraGameLogic/Interference.h>
 #include "GameTypes.h"
+#include "Rng.h"
 
 namespace gameHandling{
+    constexpr std::size_t INTERFERENCE_TYPES = 5;
+
     class MemberSelector {
     public:
-        explicit MemberSelector(const std::shared_ptr<gameModel::Team> &team);
+        /**
+         * Constructor
+         * @param team the Team to select members from
+         * @param rng random number generator of the game, has to outlive the MemberSelector
+         */
+        MemberSelector(const std::shared_ptr<gameModel::Team> &team, Rng &rng);
 
         /**
          *
@@ -77,25 +86,37 @@ namespace gameHandling{
 
     private:
         std::shared_ptr<const gameModel::Team> team; ///<The immutable Team used to reset the internal state of the MemberSelector
-        std::deque<std::shared_ptr<gameModel::Player>> playersLeft; ///<List with all currently available Players
-        std::deque<std::pair<gameModel::InterferenceType, int>> interferencesLeft; ///<List with all currently available Interferences and their respective uses
+        std::array<std::shared_ptr<gameModel::Player>, PLAYERS_PER_TEAM> players; ///<All Players of the Team, fixed at construction
+        std::array<std::uint8_t, PLAYERS_PER_TEAM> playersLeft = {}; ///<Indices into players, the first playersLeftCount entries are available
+        std::size_t playersLeftCount = 0; ///<Number of currently available Players
+        std::array<std::pair<gameModel::InterferenceType, int>, INTERFERENCE_TYPES> interferencesLeft = {}; ///<Currently available Interferences and their respective uses, the first interferencesLeftCount entries are valid
+        std::size_t interferencesLeftCount = 0; ///<Number of currently available Interferences
+        Rng &rng; ///<Random number generator of the game
 
         /**
-         *
-         * @tparam T Type of deque
+         * Removes the element at index from the first count elements of list by swapping it with the last valid element
+         * @tparam T Type of the array elements
+         * @tparam N Capacity of the array
          * @param list
-         * @return iterator to a randomly choosen element of the deque
+         * @param count number of valid elements in list, decremented by one
+         * @param index the index to be removed
+         */
+        template <typename T, std::size_t N>
+        static void swapRemove(std::array<T, N> &list, std::size_t &count, std::size_t index);
+
+        /**
+         *
+         * @param count number of valid elements
+         * @return a randomly chosen index in [0, count)
          */
-        template <typename T>
-        auto selectRandom(std::deque<T> &list) const -> typename std::deque<T>::iterator;
+        auto selectRandom(std::size_t count) -> std::size_t;
     };
 
 
-    template<typename T>
-    auto MemberSelector::selectRandom(std::deque<T> &list) const -> typename std::deque<T>::iterator {
-        int index = gameController::rng(0, static_cast<int>(list.size()) - 1);
-        return list.begin() + index;
+    template<typename T, std::size_t N>
+    void MemberSelector::swapRemove(std::array<T, N> &list, std::size_t &count, std::size_t index) {
+        std::swap(list[index], list[--count]);
     }
 }
 
-#endif
\ No newline at end of file
+#endif
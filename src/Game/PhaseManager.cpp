@@ -8,89 +8,90 @@
 namespace gameHandling{
     PhaseManager::PhaseManager(const std::shared_ptr<gameModel::Team> &team1,
              const std::shared_ptr<gameModel::Team> &team2, std::shared_ptr<const gameModel::Environment> env,
-             Timeouts timeouts) : team1(team1), team2(team2), env(std::move(env)), timeouts(timeouts){
+             Timeouts timeouts, Rng &rng) : team1(team1, rng), team2(team2, rng), env(std::move(env)), timeouts(timeouts), rng(rng){
         chooseSide(currentSidePlayers);
         chooseSide(currentSideInter);
     }
 
     auto PhaseManager::nextPlayer() -> std::optional<communication::messages::broadcast::Next> {
         using namespace communication::messages;
-        bool noTurnAllowed = false;
-        if(currentPlayer.has_value() && currentPlayer.value()->isFined){
-            playerTurnState = PlayerTurnState::Move;
-            currentPlayer.reset();
-            return nextPlayer();
-        }
+        while(true){
+            bool noTurnAllowed = false;
+            if(currentPlayer.has_value() && currentPlayer.value()->isFined){
+                playerTurnState = PlayerTurnState::Move;
+                currentPlayer.reset();
+                continue;
+            }
 
-        switch (playerTurnState){
-            case PlayerTurnState::Move:
-                switch (teamStatePlayers){
-                    case TeamState::BothAvailable:{
-                        auto &team = getTeam(currentSidePlayers);
-                        currentPlayer = team.getNextPlayer();
-                        if(currentPlayer.value()->knockedOut || currentPlayer.value()->isFined){
-                            currentPlayer.value()->knockedOut = false;
-                            noTurnAllowed = true;
-                        }
+            switch (playerTurnState){
+                case PlayerTurnState::Move:
+                    switch (teamStatePlayers){
+                        case TeamState::BothAvailable:{
+                            auto &team = getTeam(currentSidePlayers);
+                            currentPlayer = team.getNextPlayer();
+                            if(currentPlayer.value()->knockedOut || currentPlayer.value()->isFined){
+                                currentPlayer.value()->knockedOut = false;
+                                noTurnAllowed = true;
+                            }
+
+                            if(!team.hasPlayers()){
+                                teamStatePlayers = TeamState::OneEmpty;
+                                switchSide(currentSidePlayers);
+                                break;
+                            }
+
+                            if(!currentPlayer.value()->isFined){
+                                switchSide(currentSidePlayers);
+                            }
 
-                        if(!team.hasPlayers()){
-                            teamStatePlayers = TeamState::OneEmpty;
-                            switchSide(currentSidePlayers);
                             break;
                         }
 
-                        if(!currentPlayer.value()->isFined){
-                            switchSide(currentSidePlayers);
-                        }
-
-                        break;
-                    }
+                        case TeamState::OneEmpty:{
+                            auto &team = getTeam(currentSidePlayers);
+                            currentPlayer = team.getNextPlayer();
+                            if(currentPlayer.value()->knockedOut || currentPlayer.value()->isFined){
+                                currentPlayer.value()->knockedOut = false;
+                                noTurnAllowed = true;
+                            }
 
-                    case TeamState::OneEmpty:{
-                        auto &team = getTeam(currentSidePlayers);
-                        currentPlayer = team.getNextPlayer();
-                        if(currentPlayer.value()->knockedOut || currentPlayer.value()->isFined){
-                            currentPlayer.value()->knockedOut = false;
-                            noTurnAllowed = true;
-                        }
+                            if(!team.hasPlayers()){
+                                teamStatePlayers = TeamState::BothEmpty;
+                            }
 
-                        if(!team.hasPlayers()){
-                            teamStatePlayers = TeamState::BothEmpty;
+                            break;
                         }
 
-                        break;
+                        case TeamState::BothEmpty:
+                            return {};
                     }
 
-                    case TeamState::BothEmpty:
-                        return {};
-                }
+                    if(noTurnAllowed){
+                        continue;
+                    }
 
-                if(noTurnAllowed){
-                    return nextPlayer();
-                }
+                    if(rng.actionTriggered(env->config.getExtraTurnProb(currentPlayer.value()->broom))){
+                        playerTurnState = PlayerTurnState::ExtraMove;
+                    } else {
+                        playerTurnState = PlayerTurnState::PossibleAction;
+                    }
 
-                if(gameController::actionTriggered(env->config.getExtraTurnProb(currentPlayer.value()->broom))){
-                    playerTurnState = PlayerTurnState::ExtraMove;
-                } else {
+                    return broadcast::Next{currentPlayer.value()->getId(), types::TurnType::MOVE, timeouts.playerTurn};
+                case PlayerTurnState::ExtraMove:
                     playerTurnState = PlayerTurnState::PossibleAction;
-                }
-
-                return broadcast::Next{currentPlayer.value()->getId(), types::TurnType::MOVE, timeouts.playerTurn};
-            case PlayerTurnState::ExtraMove:
-                playerTurnState = PlayerTurnState::PossibleAction;
-                return broadcast::Next{currentPlayer.value()->getId(), types::TurnType::MOVE, timeouts.playerTurn};
-            case PlayerTurnState::PossibleAction:
-                playerTurnState = PlayerTurnState::Move;
-                if(gameController::playerCanPerformAction(currentPlayer.value(), env)){
-                    auto id = currentPlayer.value()->getId();
-                    currentPlayer.reset();
-                    return broadcast::Next{id, types::TurnType::ACTION, timeouts.playerTurn};
-                } else {
-                    return nextPlayer();
-                }
+                    return broadcast::Next{currentPlayer.value()->getId(), types::TurnType::MOVE, timeouts.playerTurn};
+                case PlayerTurnState::PossibleAction:
+                    playerTurnState = PlayerTurnState::Move;
+                    if(gameController::playerCanPerformAction(currentPlayer.value(), env)){
+                        auto id = currentPlayer.value()->getId();
+                        currentPlayer.reset();
+                        return broadcast::Next{id, types::TurnType::ACTION, timeouts.playerTurn};
+                    }
 
-            default:
-                throw std::runtime_error("Enum out of bounds");
+                    continue;
+                default:
+                    throw std::runtime_error("Enum out of bounds");
+            }
         }
     }
 
@@ -167,8 +168,8 @@ namespace gameHandling{
         return team1.getSide() == side ? team1 : team2;
     }
 
-    void PhaseManager::chooseSide(gameModel::TeamSide &side) const{
-        if(gameController::rng(0, 1)){
+    void PhaseManager::chooseSide(gameModel::TeamSide &side){
+        if(rng(0, 1)){
             side = gameModel::TeamSide::LEFT;
         } else {
             side = gameModel::TeamSide::RIGHT;
@@ -12,6 +12,7 @@
 #include <queue>
 #include "GameTypes.h"
 #include "MemberSelector.h"
+#include "Rng.h"
 
 namespace gameHandling{
     enum class PlayerTurnState{
@@ -28,9 +29,17 @@ namespace gameHandling{
 
     class PhaseManager {
     public:
+        /**
+         * Constructor
+         * @param team1
+         * @param team2
+         * @param env
+         * @param timeouts
+         * @param rng random number generator of the game, has to outlive the PhaseManager
+         */
         PhaseManager(const std::shared_ptr<gameModel::Team> &team1,
                      const std::shared_ptr<gameModel::Team> &team2,
-                     std::shared_ptr<const gameModel::Environment> env, Timeouts timeouts);
+                     std::shared_ptr<const gameModel::Environment> env, Timeouts timeouts, Rng &rng);
 
         /**
          * Returns the next Player action required by a client
@@ -95,12 +104,13 @@ namespace gameHandling{
         TeamState teamStatePlayers = TeamState::BothAvailable; ///<State of the Memberselectors
         TeamState teamStateInterferences = TeamState::BothAvailable; ///<State of the Memberselectors
         gameHandling::Timeouts timeouts;
+        Rng &rng; ///<Random number generator of the game
 
         /**
          * Randomly initializes the given Teamside
          * @param side
          */
-        void chooseSide(gameModel::TeamSide &side) const;
+        void chooseSide(gameModel::TeamSide &side);
 
         /**
          * gets the Memberselector by teamside
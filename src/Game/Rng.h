@@ -0,0 +1,105 @@
+#ifndef KITRAINING_RNG_H
+#define KITRAINING_RNG_H
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+namespace gameHandling {
+    /**
+     * Small and fast pseudo random number generator (xoshiro256**) owned by a single game. It draws the choices made
+     * by the game itself: the member selection, the side choice and the disqualification tie-break.
+     * The actions, ball turns and fan turns executed by SopraGameLogic still draw from the random generator of the
+     * library, which is shared by the whole process and can not be seeded. Games with the same seed are therefore not
+     * deterministic, and these calls are serialised by gameLogicMutex when games run in parallel.
+     */
+    class Rng {
+    public:
+        /**
+         * Constructs a generator, the internal state is derived from the seed using splitmix64
+         * @param seed
+         */
+        explicit Rng(std::uint64_t seed);
+
+        /**
+         * @return the next 64 random bits
+         */
+        auto next() -> std::uint64_t;
+
+        /**
+         * Uniformly draws an integer, same contract as gameController::rng
+         * @param min lower bound (inclusive)
+         * @param max upper bound (inclusive)
+         * @return random number in [min, max]
+         */
+        int operator()(int min, int max);
+
+        /**
+         * Same contract as gameController::actionTriggered
+         * @param prob probability of returning true
+         * @return true with the given probability
+         */
+        bool actionTriggered(double prob);
+
+        /**
+         * @return random number in [0, 1)
+         */
+        auto uniform() -> double;
+
+        /**
+         * @return a non deterministic seed for runs without a fixed seed
+         */
+        static auto randomSeed() -> std::uint64_t;
+
+    private:
+        std::array<std::uint64_t, 4> s; ///< Generator state
+
+        static constexpr auto rotl(std::uint64_t x, int k) -> std::uint64_t;
+    };
+
+    inline Rng::Rng(std::uint64_t seed) : s{} {
+        for(auto &word : s){
+            seed += 0x9e3779b97f4a7c15ULL;
+            auto z = seed;
+            z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31U);
+        }
+    }
+
+    constexpr auto Rng::rotl(std::uint64_t x, int k) -> std::uint64_t {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    inline auto Rng::next() -> std::uint64_t {
+        auto result = rotl(s[1] * 5, 7) * 9;
+        auto t = s[1] << 17U;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    inline int Rng::operator()(int min, int max) {
+        auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+        return min + static_cast<int>(((next() >> 32U) * range) >> 32U);
+    }
+
+    inline bool Rng::actionTriggered(double prob) {
+        return uniform() < prob;
+    }
+
+    inline auto Rng::uniform() -> double {
+        return static_cast<double>(next() >> 11U) * 0x1.0p-53;
+    }
+
+    inline auto Rng::randomSeed() -> std::uint64_t {
+        std::random_device rd;
+        return (static_cast<std::uint64_t>(rd()) << 32U) ^ rd();
+    }
+}
+
+#endif //KITRAINING_RNG_H
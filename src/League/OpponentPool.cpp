@@ -0,0 +1,61 @@
+#include "OpponentPool.h"
+
+namespace league {
+    auto Snapshot::playing(gameModel::TeamSide side) const -> communication::FrozenNets {
+        if(side == gameModel::TeamSide::LEFT){
+            return {nets.first, nullptr};
+        }
+
+        return {nullptr, nets.second};
+    }
+
+    OpponentPool::OpponentPool(LeagueOptions options) : options(options) {
+        if(options.capacity == 0 || options.snapshotInterval <= 0){
+            throw std::runtime_error("League capacity and snapshot interval have to be positive");
+        }
+
+        if(options.selfPlayWeight < 0 || options.snapshotWeight < 0 || options.decay < 0){
+            throw std::runtime_error("League sampling weights must not be negative");
+        }
+    }
+
+    void OpponentPool::add(const communication::Nets &nets, int epoch) {
+        std::shared_ptr<const ai::StateEstimator> left = std::make_shared<const ai::StateEstimator>(*nets.first);
+        auto right = nets.first == nets.second ? left : std::make_shared<const ai::StateEstimator>(*nets.second);
+        if(snapshots.size() == options.capacity){
+            snapshots.pop_front();
+        }
+
+        snapshots.emplace_back(Snapshot{{std::move(left), std::move(right)}, epoch});
+    }
+
+    auto OpponentPool::sample(gameHandling::Rng &rng) const -> std::optional<Snapshot> {
+        double total = options.selfPlayWeight;
+        double weight = options.snapshotWeight;
+        for(std::size_t i = 0; i < snapshots.size(); i++){
+            total += weight;
+            weight *= options.decay;
+        }
+
+        auto draw = rng.uniform() * total;
+        weight = options.snapshotWeight;
+        for(auto it = snapshots.rbegin(); it != snapshots.rend(); it++){
+            if(draw < weight){
+                return *it;
+            }
+
+            draw -= weight;
+            weight *= options.decay;
+        }
+
+        return std::nullopt;
+    }
+
+    auto OpponentPool::size() const -> std::size_t {
+        return snapshots.size();
+    }
+
+    auto OpponentPool::getOptions() const -> const LeagueOptions & {
+        return options;
+    }
+}
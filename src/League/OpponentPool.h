@@ -0,0 +1,80 @@
+#ifndef KITRAINING_OPPONENTPOOL_H
+#define KITRAINING_OPPONENTPOOL_H
+
+#include <deque>
+#include <optional>
+#include <Communication/Communicator.h>
+#include <Game/Rng.h>
+
+namespace league {
+    /**
+     * Frozen copies of the networks of both teams at one point of the training
+     */
+    struct Snapshot {
+        communication::FrozenNets nets; ///< The same network twice if both teams train a shared network
+        int epoch;
+
+        /**
+         * @param side the team playing the snapshot
+         * @return the frozen networks of a game in which only the given team plays the snapshot
+         */
+        auto playing(gameModel::TeamSide side) const -> communication::FrozenNets;
+    };
+
+    /**
+     * Options of the league
+     */
+    struct LeagueOptions {
+        std::size_t capacity = 32; ///< Maximum number of snapshots, the oldest one is dropped when the pool is full
+        int snapshotInterval = 1000; ///< Epochs between two snapshots
+        double selfPlayWeight = 1; ///< Sampling weight of playing against the current networks
+        double snapshotWeight = 1; ///< Sampling weight of the newest snapshot
+        double decay = 1; ///< Weight of a snapshot relative to the next newer one, 1 samples all snapshots uniformly
+    };
+
+    /**
+     * Pool of frozen past networks the learning networks play against. A snapshot is an immutable copy of the
+     * networks, no optimizer state is kept, so the pool can hold dozens of them. The pool itself is not thread safe,
+     * the networks of a sampled snapshot are only read and can be shared by any number of games and threads.
+     */
+    class OpponentPool {
+    public:
+        /**
+         * Constructor
+         * @param options
+         */
+        explicit OpponentPool(LeagueOptions options);
+
+        /**
+         * Adds a frozen copy of the current networks, drops the oldest snapshot if the pool is full
+         * @param nets the learning networks, one copy is made if both teams use the same network
+         * @param epoch
+         */
+        void add(const communication::Nets &nets, int epoch);
+
+        /**
+         * Samples the opponent of a game. Self play has the weight selfPlayWeight, the i-th newest snapshot the weight
+         * snapshotWeight * decay^i.
+         * @param rng
+         * @return the sampled snapshot, nullopt for self play
+         */
+        auto sample(gameHandling::Rng &rng) const -> std::optional<Snapshot>;
+
+        /**
+         * @return number of snapshots in the pool
+         */
+        auto size() const -> std::size_t;
+
+        /**
+         * Getter
+         * @return
+         */
+        auto getOptions() const -> const LeagueOptions &;
+
+    private:
+        LeagueOptions options;
+        std::deque<Snapshot> snapshots; ///< Oldest first
+    };
+}
+
+#endif //KITRAINING_OPPONENTPOOL_H
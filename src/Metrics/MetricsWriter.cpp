@@ -0,0 +1,55 @@
+#include <nlohmann/json.hpp>
+#include "MetricsWriter.h"
+
+namespace metrics {
+    MetricsWriter::MetricsWriter(const std::string &fileName, std::size_t batchSize) : file(fileName),
+        batchSize(batchSize) {
+        if(!file.good()){
+            throw std::runtime_error("Could not open metrics file " + fileName);
+        }
+    }
+
+    MetricsWriter::~MetricsWriter() {
+        flush();
+    }
+
+    void MetricsWriter::write(const GameRecord &record) {
+        const auto &statistics = record.statistics;
+        nlohmann::json json;
+        json["epoch"] = record.epoch;
+        json["game"] = record.game;
+        json["steps"] = statistics.steps;
+        json["decisions"] = statistics.decisions;
+        json["rounds"] = statistics.rounds;
+        if(statistics.result.has_value()){
+            json["winner"] = statistics.result->first == gameModel::TeamSide::LEFT ? "left" : "right";
+            json["victoryReason"] = communication::messages::types::toString(statistics.result->second);
+        }
+
+        json["tdUpdates"] = statistics.tdUpdates();
+        json["meanAbsTdError"] = (statistics.trainingLeft.absTdErrorSum + statistics.trainingRight.absTdErrorSum) /
+                std::max<std::size_t>(statistics.trainingLeft.tdErrors + statistics.trainingRight.tdErrors, 1);
+        json["maxAbsTdError"] = std::max(statistics.trainingLeft.maxAbsTdError, statistics.trainingRight.maxAbsTdError);
+        json["lossLeft"] = statistics.trainingLeft.meanLoss();
+        json["lossRight"] = statistics.trainingRight.meanLoss();
+        json["epochSeconds"] = record.epochSeconds;
+        json["gamesPerSecond"] = record.gamesPerSecond;
+
+        buffer += json.dump();
+        buffer += '\n';
+        if(++bufferedRecords >= batchSize){
+            flush();
+        }
+    }
+
+    void MetricsWriter::flush() {
+        if(bufferedRecords == 0){
+            return;
+        }
+
+        file << buffer;
+        file.flush();
+        buffer.clear();
+        bufferedRecords = 0;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef KITRAINING_METRICSWRITER_H
+#define KITRAINING_METRICSWRITER_H
+
+#include <fstream>
+#include <string>
+#include <Communication/Communicator.h>
+
+namespace metrics {
+    /**
+     * Metrics of one game of a training epoch
+     */
+    struct GameRecord {
+        int epoch;
+        std::size_t game; ///< Index of the game within the epoch
+        communication::GameStatistics statistics;
+        double epochSeconds; ///< Wall time of the whole epoch
+        double gamesPerSecond; ///< Games of the epoch divided by its wall time
+    };
+
+    /**
+     * Writes one JSON object per game to a JSONL file. Records are buffered and written in batches.
+     */
+    class MetricsWriter {
+    public:
+        /**
+         * Constructor
+         * @param fileName the file is truncated
+         * @param batchSize number of buffered records after which the buffer is written
+         */
+        explicit MetricsWriter(const std::string &fileName, std::size_t batchSize = 64);
+
+        ~MetricsWriter();
+
+        MetricsWriter(const MetricsWriter &) = delete;
+        auto operator=(const MetricsWriter &) -> MetricsWriter & = delete;
+
+        /**
+         * Buffers a record and writes the buffer if it is full
+         * @param record
+         */
+        void write(const GameRecord &record);
+
+        /**
+         * Writes all buffered records
+         */
+        void flush();
+
+    private:
+        std::ofstream file;
+        std::string buffer;
+        std::size_t bufferedRecords = 0;
+        std::size_t batchSize;
+    };
+}
+
+#endif //KITRAINING_METRICSWRITER_H
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include "AllocationTracker.h"
+
+namespace profiling {
+    /**
+     * Counters of one thread. They live in static storage because they are used by operator new, so creating them
+     * must not allocate.
+     */
+    struct ThreadAllocations {
+        std::array<std::atomic<std::uint64_t>, REGION_COUNT> allocations = {};
+        std::array<std::atomic<std::uint64_t>, REGION_COUNT> bytes = {};
+        std::array<std::atomic<std::uint64_t>, REGION_COUNT> deallocations = {};
+    };
+
+    /**
+     * Threads beyond this number share the last slot
+     */
+    constexpr std::size_t MAX_THREADS = 256;
+    constexpr std::size_t OUTSIDE_OF_PHASES = REGION_COUNT - 1;
+
+    std::array<ThreadAllocations, MAX_THREADS> threadSlots;
+    std::atomic<std::size_t> usedSlots{0};
+    std::atomic<std::int64_t> liveBytes{0};
+    std::atomic<std::int64_t> peakLiveBytes{0};
+    thread_local std::size_t currentRegion = OUTSIDE_OF_PHASES;
+
+    auto threadAllocations() -> ThreadAllocations & {
+        thread_local std::size_t slot = std::min(usedSlots.fetch_add(1, std::memory_order_relaxed), MAX_THREADS - 1);
+        return threadSlots[slot];
+    }
+
+    void countAllocation(std::size_t size) {
+        auto &counters = threadAllocations();
+        counters.allocations[currentRegion].fetch_add(1, std::memory_order_relaxed);
+        counters.bytes[currentRegion].fetch_add(size, std::memory_order_relaxed);
+        auto live = liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed) + static_cast<std::int64_t>(size);
+        auto peak = peakLiveBytes.load(std::memory_order_relaxed);
+        while(live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)){}
+    }
+
+    void countDeallocation(std::size_t size) {
+        threadAllocations().deallocations[currentRegion].fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    }
+
+    AllocationRegion::AllocationRegion(Phase phase) : previous(currentRegion) {
+        currentRegion = static_cast<std::size_t>(phase);
+    }
+
+    AllocationRegion::~AllocationRegion() {
+        currentRegion = previous;
+    }
+
+    auto collectAllocations() -> AllocationReport {
+        AllocationReport report;
+        auto slots = std::min(usedSlots.load(std::memory_order_relaxed), MAX_THREADS);
+        for(std::size_t slot = 0; slot < slots; slot++){
+            for(std::size_t region = 0; region < REGION_COUNT; region++){
+                report.regions[region].allocations += threadSlots[slot].allocations[region].load(std::memory_order_relaxed);
+                report.regions[region].bytes += threadSlots[slot].bytes[region].load(std::memory_order_relaxed);
+                report.regions[region].deallocations += threadSlots[slot].deallocations[region].load(std::memory_order_relaxed);
+            }
+        }
+
+        report.liveBytes = liveBytes.load(std::memory_order_relaxed);
+        report.peakLiveBytes = peakLiveBytes.load(std::memory_order_relaxed);
+        return report;
+    }
+
+    void resetAllocations() {
+        auto slots = std::min(usedSlots.load(std::memory_order_relaxed), MAX_THREADS);
+        for(std::size_t slot = 0; slot < slots; slot++){
+            for(std::size_t region = 0; region < REGION_COUNT; region++){
+                threadSlots[slot].allocations[region].store(0, std::memory_order_relaxed);
+                threadSlots[slot].bytes[region].store(0, std::memory_order_relaxed);
+                threadSlots[slot].deallocations[region].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        peakLiveBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    auto toString(const AllocationReport &report) -> std::string {
+        std::stringstream stream;
+        for(std::size_t region = 0; region < REGION_COUNT; region++){
+            const auto &totals = report.regions[region];
+            auto name = region == OUTSIDE_OF_PHASES ? std::string{"other"} : toString(static_cast<Phase>(region));
+            stream << std::setw(16) << name << ": " << totals.allocations << " allocations, " << totals.bytes
+                   << " bytes, " << totals.deallocations << " deallocations\n";
+        }
+
+        stream << std::setw(16) << "live" << ": " << report.liveBytes << " bytes, peak " << report.peakLiveBytes << " bytes\n";
+        return stream.str();
+    }
+}
+
+#ifdef KITRAINING_ALLOCATION_TRACKING
+namespace {
+    /**
+     * Every block starts with a header storing its size, which keeps the alignment guaranteed by malloc
+     */
+    constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    auto trackedAllocate(std::size_t size) noexcept -> void * {
+        auto block = static_cast<char *>(std::malloc(size + HEADER_SIZE));
+        if(block == nullptr){
+            return nullptr;
+        }
+
+        *reinterpret_cast<std::size_t *>(block) = size;
+        profiling::countAllocation(size);
+        return block + HEADER_SIZE;
+    }
+
+    void trackedFree(void *pointer) noexcept {
+        if(pointer == nullptr){
+            return;
+        }
+
+        auto block = static_cast<char *>(pointer) - HEADER_SIZE;
+        profiling::countDeallocation(*reinterpret_cast<std::size_t *>(block));
+        std::free(block);
+    }
+}
+
+auto operator new(std::size_t size) -> void * {
+    auto pointer = trackedAllocate(size);
+    if(pointer == nullptr){
+        throw std::bad_alloc{};
+    }
+
+    return pointer;
+}
+
+auto operator new[](std::size_t size) -> void * {
+    return operator new(size);
+}
+
+auto operator new(std::size_t size, const std::nothrow_t &) noexcept -> void * {
+    return trackedAllocate(size);
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t &) noexcept -> void * {
+    return trackedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    trackedFree(pointer);
+}
+#endif
@@ -0,0 +1,71 @@
+#ifndef KITRAINING_ALLOCATIONTRACKER_H
+#define KITRAINING_ALLOCATIONTRACKER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include "Phase.h"
+
+namespace profiling {
+    /**
+     * Allocations outside of all phases are attributed to the last region
+     */
+    constexpr std::size_t REGION_COUNT = PHASE_COUNT + 1;
+
+    struct AllocationTotals {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t deallocations = 0;
+    };
+
+    struct AllocationReport {
+        std::array<AllocationTotals, REGION_COUNT> regions;
+        std::int64_t liveBytes = 0; ///< Bytes allocated with operator new and not yet freed
+        std::int64_t peakLiveBytes = 0; ///< Maximum of liveBytes since the last reset
+    };
+
+    /**
+     * Attributes all allocations and deallocations of the calling thread within the enclosing scope to a phase.
+     * Regions can be nested, the innermost region counts.
+     */
+    class AllocationRegion {
+    public:
+        explicit AllocationRegion(Phase phase);
+        ~AllocationRegion();
+        AllocationRegion(const AllocationRegion &) = delete;
+        auto operator=(const AllocationRegion &) -> AllocationRegion & = delete;
+
+    private:
+        std::size_t previous;
+    };
+
+    /**
+     * Sums the counters of all threads, only meaningful if KITRAINING_ALLOCATION_TRACKING is defined
+     * @return allocations per region since the last reset
+     */
+    auto collectAllocations() -> AllocationReport;
+
+    /**
+     * Sets all counters to zero and the peak to the current number of live bytes
+     */
+    void resetAllocations();
+
+    /**
+     * @param report
+     * @return one line per region with allocations, bytes and deallocations followed by live and peak live bytes
+     */
+    auto toString(const AllocationReport &report) -> std::string;
+
+    /**
+     * @return true if the global operator new and delete are replaced by counting versions
+     */
+    constexpr bool allocationTrackingEnabled() {
+#ifdef KITRAINING_ALLOCATION_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+}
+
+#endif //KITRAINING_ALLOCATIONTRACKER_H
@@ -0,0 +1,28 @@
+#ifndef KITRAINING_PHASE_H
+#define KITRAINING_PHASE_H
+
+#include <cstddef>
+#include <string>
+
+namespace profiling {
+    /**
+     * Parts of a game whose time and allocations are accumulated
+     */
+    enum class Phase {
+        BallTurn,
+        PlayerDecision,
+        FanTurn,
+        GetState,
+        TdUpdate
+    };
+
+    constexpr std::size_t PHASE_COUNT = 5;
+
+    /**
+     * @param phase
+     * @return name of the phase
+     */
+    auto toString(Phase phase) -> std::string;
+}
+
+#endif //KITRAINING_PHASE_H
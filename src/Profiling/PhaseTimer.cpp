@@ -0,0 +1,101 @@
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <iomanip>
+#include <vector>
+#include "PhaseTimer.h"
+
+namespace profiling {
+    /**
+     * Accumulators of all threads that ever used a timer
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadAccumulators>> accumulators;
+    };
+
+    auto registry() -> Registry & {
+        static Registry instance;
+        return instance;
+    }
+
+    void ThreadAccumulators::add(Phase phase, std::uint64_t elapsed) {
+        auto index = static_cast<std::size_t>(phase);
+        // Only the owning thread writes, so there is no need for an atomic read-modify-write
+        calls[index].store(calls[index].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        nanoseconds[index].store(nanoseconds[index].load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+    }
+
+    auto threadAccumulators() -> ThreadAccumulators & {
+        thread_local ThreadAccumulators *accumulators = []{
+            auto &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            return reg.accumulators.emplace_back(std::make_unique<ThreadAccumulators>()).get();
+        }();
+
+        return *accumulators;
+    }
+
+    auto collect() -> Breakdown {
+        Breakdown breakdown;
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for(const auto &accumulators : reg.accumulators){
+            for(std::size_t i = 0; i < PHASE_COUNT; i++){
+                breakdown[i].calls += accumulators->calls[i].load(std::memory_order_relaxed);
+                breakdown[i].time += std::chrono::nanoseconds{accumulators->nanoseconds[i].load(std::memory_order_relaxed)};
+            }
+        }
+
+        return breakdown;
+    }
+
+    void reset() {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for(const auto &accumulators : reg.accumulators){
+            for(std::size_t i = 0; i < PHASE_COUNT; i++){
+                accumulators->calls[i].store(0, std::memory_order_relaxed);
+                accumulators->nanoseconds[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto toString(Phase phase) -> std::string {
+        switch (phase){
+            case Phase::BallTurn:
+                return "ball turn";
+            case Phase::PlayerDecision:
+                return "player decision";
+            case Phase::FanTurn:
+                return "fan turn";
+            case Phase::GetState:
+                return "getState";
+            case Phase::TdUpdate:
+                return "TD update";
+        }
+
+        throw std::runtime_error("Enum out of bounds");
+    }
+
+    auto toString(const Breakdown &breakdown) -> std::string {
+        std::chrono::nanoseconds total{0};
+        for(const auto &phase : breakdown){
+            total += phase.time;
+        }
+
+        std::stringstream stream;
+        stream << std::fixed << std::setprecision(2);
+        for(std::size_t i = 0; i < PHASE_COUNT; i++){
+            const auto &phase = breakdown[i];
+            auto ms = std::chrono::duration<double, std::milli>(phase.time).count();
+            auto meanUs = phase.calls == 0 ? 0.0 : std::chrono::duration<double, std::micro>(phase.time).count() / phase.calls;
+            auto share = total.count() == 0 ? 0.0 : 100.0 * phase.time.count() / total.count();
+            stream << std::setw(16) << toString(static_cast<Phase>(i)) << ": " << phase.calls << " calls, " << ms
+                   << " ms, " << meanUs << " us/call, " << share << "%\n";
+        }
+
+        return stream.str();
+    }
+}
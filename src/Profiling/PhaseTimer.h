@@ -0,0 +1,108 @@
+#ifndef KITRAINING_PHASETIMER_H
+#define KITRAINING_PHASETIMER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include "Phase.h"
+#include "AllocationTracker.h"
+
+namespace profiling {
+    using Clock = std::chrono::steady_clock;
+
+    struct PhaseTotals {
+        std::uint64_t calls = 0;
+        std::chrono::nanoseconds time{0};
+    };
+
+    using Breakdown = std::array<PhaseTotals, PHASE_COUNT>;
+
+    /**
+     * Accumulators of one thread. Only the owning thread writes, other threads may read at any time.
+     */
+    struct ThreadAccumulators {
+        std::array<std::atomic<std::uint64_t>, PHASE_COUNT> calls = {};
+        std::array<std::atomic<std::uint64_t>, PHASE_COUNT> nanoseconds = {};
+
+        void add(Phase phase, std::uint64_t elapsed);
+    };
+
+    /**
+     * @return the accumulators of the calling thread, they are kept after the thread ended
+     */
+    auto threadAccumulators() -> ThreadAccumulators &;
+
+    /**
+     * Adds the time between construction and destruction to the accumulators of the calling thread
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Phase phase);
+        ~ScopedTimer();
+        ScopedTimer(const ScopedTimer &) = delete;
+        auto operator=(const ScopedTimer &) -> ScopedTimer & = delete;
+
+    private:
+        Phase phase;
+        Clock::time_point start;
+    };
+
+    /**
+     * Sums the accumulators of all threads
+     * @return calls and time per phase since the last reset
+     */
+    auto collect() -> Breakdown;
+
+    /**
+     * Sets the accumulators of all threads to zero, should only be called while no timer is running
+     */
+    void reset();
+
+    /**
+     * @param breakdown
+     * @return one line per phase with calls, total time, mean time and share of the total time of all phases
+     */
+    auto toString(const Breakdown &breakdown) -> std::string;
+
+    /**
+     * @return true if the timers are compiled in
+     */
+    constexpr bool enabled() {
+#ifdef KITRAINING_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    inline ScopedTimer::ScopedTimer(Phase phase) : phase(phase), start(Clock::now()) {}
+
+    inline ScopedTimer::~ScopedTimer() {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        threadAccumulators().add(phase, static_cast<std::uint64_t>(elapsed));
+    }
+}
+
+#define KITRAINING_CONCAT_IMPL(a, b) a##b
+#define KITRAINING_CONCAT(a, b) KITRAINING_CONCAT_IMPL(a, b)
+
+#ifdef KITRAINING_PROFILING
+#define KITRAINING_PHASE_TIMER(phase) profiling::ScopedTimer KITRAINING_CONCAT(phaseTimer, __LINE__){phase}
+#else
+#define KITRAINING_PHASE_TIMER(phase) static_cast<void>(0)
+#endif
+
+#ifdef KITRAINING_ALLOCATION_TRACKING
+#define KITRAINING_PHASE_ALLOCATIONS(phase) profiling::AllocationRegion KITRAINING_CONCAT(allocationRegion, __LINE__){phase}
+#else
+#define KITRAINING_PHASE_ALLOCATIONS(phase) static_cast<void>(0)
+#endif
+
+/**
+ * Times the rest of the enclosing scope and attributes its allocations to the phase, each part expands to nothing
+ * unless KITRAINING_PROFILING or KITRAINING_ALLOCATION_TRACKING is defined
+ */
+#define KITRAINING_PROFILE_PHASE(phase) KITRAINING_PHASE_TIMER(phase); KITRAINING_PHASE_ALLOCATIONS(phase)
+
+#endif //KITRAINING_PHASETIMER_H
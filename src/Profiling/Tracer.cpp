@@ -0,0 +1,105 @@
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "Tracer.h"
+
+namespace profiling {
+    std::atomic<bool> Tracer::recording{false};
+
+    struct TraceEvent {
+        const char *name;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    /**
+     * Events of one thread, only the owning thread appends
+     */
+    struct ThreadBuffer {
+        std::size_t threadId = 0;
+        std::mutex mutex; ///< Guards events against write
+        std::vector<TraceEvent> events;
+    };
+
+    struct TraceRegistry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        Clock::time_point origin = Clock::now();
+    };
+
+    auto traceRegistry() -> TraceRegistry & {
+        static TraceRegistry instance;
+        return instance;
+    }
+
+    auto threadBuffer() -> ThreadBuffer & {
+        thread_local ThreadBuffer *buffer = []{
+            auto &reg = traceRegistry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            auto &created = reg.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+            created->threadId = reg.buffers.size() - 1;
+            return created.get();
+        }();
+
+        return *buffer;
+    }
+
+    void Tracer::setRecording(bool recording) {
+        Tracer::recording.store(recording, std::memory_order_relaxed);
+    }
+
+    void Tracer::record(const char *name, Clock::time_point start, Clock::time_point end) {
+        auto &buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.events.emplace_back(TraceEvent{name, start, end});
+    }
+
+    void Tracer::write(const std::string &fileName) {
+        auto &reg = traceRegistry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto toUs = [&reg](Clock::time_point time){
+            return std::chrono::duration<double, std::micro>(time - reg.origin).count();
+        };
+
+        auto events = nlohmann::json::array();
+        std::vector<TraceEvent> recorded;
+        for(const auto &buffer : reg.buffers){
+            {
+                // The events are taken out under the lock, the owning thread keeps recording into an empty buffer
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                recorded.clear();
+                recorded.swap(buffer->events);
+            }
+
+            nlohmann::json threadName;
+            threadName["name"] = "thread_name";
+            threadName["ph"] = "M";
+            threadName["pid"] = 1;
+            threadName["tid"] = buffer->threadId;
+            threadName["args"]["name"] = "thread " + std::to_string(buffer->threadId);
+            events.push_back(threadName);
+            for(const auto &event : recorded){
+                nlohmann::json json;
+                json["name"] = event.name;
+                json["ph"] = "X";
+                json["pid"] = 1;
+                json["tid"] = buffer->threadId;
+                json["ts"] = toUs(event.start);
+                json["dur"] = toUs(event.end) - toUs(event.start);
+                events.push_back(json);
+            }
+        }
+
+        nlohmann::json trace;
+        trace["traceEvents"] = events;
+        trace["displayTimeUnit"] = "ms";
+        std::ofstream file{fileName};
+        if(!file.good()){
+            throw std::runtime_error("Could not open trace file " + fileName);
+        }
+
+        file << trace.dump();
+    }
+}
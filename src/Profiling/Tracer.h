@@ -0,0 +1,82 @@
+#ifndef KITRAINING_TRACER_H
+#define KITRAINING_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include "PhaseTimer.h"
+
+namespace profiling {
+    /**
+     * Records complete events (begin and duration) of named scopes and writes them in the Chrome trace-event format,
+     * which can be opened with chrome://tracing or Perfetto. Every thread appends to its own buffer, guarded by a mutex
+     * of the buffer which is only contended while write takes the events out, so write may be called while other
+     * threads are recording.
+     */
+    class Tracer {
+    public:
+        /**
+         * Starts or stops recording, scopes started while recording is stopped are not recorded
+         * @param recording
+         */
+        static void setRecording(bool recording);
+
+        /**
+         * @return true if scopes are recorded
+         */
+        static bool isRecording();
+
+        /**
+         * Appends an event to the buffer of the calling thread
+         * @param name has to outlive the next call to write
+         * @param start
+         * @param end
+         */
+        static void record(const char *name, Clock::time_point start, Clock::time_point end);
+
+        /**
+         * Writes the events of all threads to a trace file and clears the buffers
+         * @param fileName
+         */
+        static void write(const std::string &fileName);
+
+    private:
+        static std::atomic<bool> recording;
+    };
+
+    /**
+     * Records the enclosing scope if the Tracer is recording
+     */
+    class TraceScope {
+    public:
+        explicit TraceScope(const char *name);
+        ~TraceScope();
+        TraceScope(const TraceScope &) = delete;
+        auto operator=(const TraceScope &) -> TraceScope & = delete;
+
+    private:
+        const char *name;
+        bool active;
+        Clock::time_point start;
+    };
+
+    inline bool Tracer::isRecording() {
+        return recording.load(std::memory_order_relaxed);
+    }
+
+    inline TraceScope::TraceScope(const char *name) : name(name), active(Tracer::isRecording()) {
+        if(active){
+            start = Clock::now();
+        }
+    }
+
+    inline TraceScope::~TraceScope() {
+        if(active){
+            Tracer::record(name, start, Clock::now());
+        }
+    }
+}
+
+#define KITRAINING_TRACE_SCOPE(name) profiling::TraceScope KITRAINING_CONCAT(traceScope, __LINE__){name}
+
+#endif //KITRAINING_TRACER_H
@@ -0,0 +1,27 @@
+#include <SopraAITools/AITools.h>
+#include "Actor.h"
+
+namespace simulation {
+    Actor::Actor(communication::messages::broadcast::MatchConfig matchConfig,
+                 communication::messages::request::TeamConfig leftTeamConfig,
+                 communication::messages::request::TeamConfig rightTeamConfig, bool sharedNetwork) :
+                 matchConfig(std::move(matchConfig)), leftTeamConfig(std::move(leftTeamConfig)),
+                 rightTeamConfig(std::move(rightTeamConfig)), sharedNetwork(sharedNetwork) {}
+
+    auto Actor::play(const communication::FrozenNets &nets, std::uint64_t seed, const ai::TransitionSink &sink,
+                     const std::shared_ptr<ai::ThreadPool> &pool) const -> communication::GameStatistics {
+        std::ostream nullStream{nullptr};
+        util::Logging log{nullStream, 0};
+        // The AIs of ActorLearner rate on its pool and can not use a value cache, those of ActorClient rate on this thread
+        ai::SearchOptions searchOptions{true, 1, pool, pool ? 0 : ai::SearchOptions::GAME_CACHE_CAPACITY};
+        gameHandling::Game game{matchConfig, leftTeamConfig, rightTeamConfig,
+                                aiTools::getTeamFormation(gameModel::TeamSide::LEFT),
+                                aiTools::getTeamFormation(gameModel::TeamSide::RIGHT), log, "---", seed};
+        std::pair<ai::AI, ai::AI> ais{ai::AI{game.environment, gameModel::TeamSide::LEFT, nets.first, log, searchOptions},
+                                      ai::AI{game.environment, gameModel::TeamSide::RIGHT, nets.second, log,
+                                             searchOptions, sharedNetwork}};
+        ais.first.setTransitionSink(sink);
+        ais.second.setTransitionSink(sink);
+        return communication::playGame(game, ais, log);
+    }
+}
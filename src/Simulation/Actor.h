@@ -0,0 +1,42 @@
+#ifndef KITRAINING_ACTOR_H
+#define KITRAINING_ACTOR_H
+
+#include <Communication/Communicator.h>
+
+namespace simulation {
+    /**
+     * Plays games with frozen networks and hands the transitions of both teams to a sink instead of training
+     */
+    class Actor {
+    public:
+        /**
+         * Constructor
+         * @param matchConfig
+         * @param leftTeamConfig
+         * @param rightTeamConfig
+         * @param sharedNetwork whether the networks were trained as one shared network with mirrored features
+         */
+        Actor(communication::messages::broadcast::MatchConfig matchConfig,
+              communication::messages::request::TeamConfig leftTeamConfig,
+              communication::messages::request::TeamConfig rightTeamConfig, bool sharedNetwork);
+
+        /**
+         * Plays one game, may be called by several threads at the same time
+         * @param nets the networks of both teams
+         * @param seed
+         * @param sink receives every TD(0) transition of both teams
+         * @param pool optional pool rating the candidates of the decisions
+         * @return statistics of the game
+         */
+        auto play(const communication::FrozenNets &nets, std::uint64_t seed, const ai::TransitionSink &sink,
+                  const std::shared_ptr<ai::ThreadPool> &pool = nullptr) const -> communication::GameStatistics;
+
+    private:
+        communication::messages::broadcast::MatchConfig matchConfig;
+        communication::messages::request::TeamConfig leftTeamConfig;
+        communication::messages::request::TeamConfig rightTeamConfig;
+        bool sharedNetwork;
+    };
+}
+
+#endif //KITRAINING_ACTOR_H
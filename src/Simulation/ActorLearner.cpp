@@ -0,0 +1,89 @@
+#include "ActorLearner.h"
+
+namespace simulation {
+    ActorLearner::ActorLearner(Actor actor, std::size_t actorCount, double learningRate, double discountRate,
+                               communication::Nets nets, std::uint64_t seed, LearnerOptions options,
+                               communication::TargetNets targetNets, std::shared_ptr<ai::ThreadPool> pool) :
+                               actor(std::move(actor)),
+                               learner(learningRate, discountRate, std::move(nets), options, std::move(targetNets)),
+                               seed(seed), pool(pool ? std::move(pool) : std::make_shared<ai::ThreadPool>(actorCount + 1)) {
+        if(actorCount == 0){
+            throw std::runtime_error("At least one actor is needed");
+        }
+
+        if(this->pool->size() < 2){
+            // A pool without threads plays submitted games on the calling thread
+            throw std::runtime_error("The actors need a pool with at least one thread");
+        }
+
+        runningActors = actorCount;
+        for(std::size_t i = 0; i < actorCount; i++){
+            this->pool->submit([this]{ act(); });
+        }
+    }
+
+    ActorLearner::~ActorLearner() {
+        stopping = true;
+        std::unique_lock<std::mutex> lock{gamesMutex};
+        actorStopped.wait(lock, [this]{ return runningActors == 0; });
+    }
+
+    auto ActorLearner::collectGames() -> std::vector<communication::GameStatistics> {
+        std::unique_lock<std::mutex> lock{gamesMutex};
+        gameFinished.wait(lock, [this]{ return !finishedGames.empty() || error; });
+        if(error){
+            std::rethrow_exception(error);
+        }
+
+        std::vector<communication::GameStatistics> games;
+        games.swap(finishedGames);
+        return games;
+    }
+
+    auto ActorLearner::getPublishedNets() const -> std::shared_ptr<const communication::FrozenNets> {
+        return learner.getPublishedNets();
+    }
+
+    auto ActorLearner::getStatistics() const -> LearnerStatistics {
+        return learner.getStatistics();
+    }
+
+    void ActorLearner::act() {
+        if(stopping){
+            stopActor();
+            return;
+        }
+
+        auto sink = [this](ai::Transition &&transition){
+            learner.push(std::move(transition));
+        };
+
+        try {
+            auto statistics = actor.play(*learner.getPublishedNets(), seed + nextGame++, sink, pool);
+            {
+                std::lock_guard<std::mutex> lock{gamesMutex};
+                finishedGames.emplace_back(statistics);
+            }
+
+            gameFinished.notify_one();
+        } catch (...) {
+            stopActor(std::current_exception());
+            return;
+        }
+
+        // A new task instead of a loop, so that the games and the candidates of all actors share the workers
+        pool->submit([this]{ act(); });
+    }
+
+    void ActorLearner::stopActor(std::exception_ptr exception) {
+        // The destructor may return as soon as runningActors is 0, this is only touched under the lock
+        std::lock_guard<std::mutex> lock{gamesMutex};
+        if(exception && !error){
+            error = exception;
+            gameFinished.notify_all();
+        }
+
+        runningActors--;
+        actorStopped.notify_all();
+    }
+}
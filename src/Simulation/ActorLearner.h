@@ -0,0 +1,79 @@
+#ifndef KITRAINING_ACTORLEARNER_H
+#define KITRAINING_ACTORLEARNER_H
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include "Actor.h"
+#include "AsyncTrainer.h"
+
+namespace simulation {
+    /**
+     * Trains with simulation and training on separate threads of this process. Actors play games with the last
+     * published weights and push their transitions to the Learner. Every game is a task of a work-stealing pool which
+     * queues the next game of its actor when it ends, workers without a game help rating the candidates of the others.
+     */
+    class ActorLearner : public AsyncTrainer {
+    public:
+        /**
+         * Constructor, starts all threads
+         * @param actor plays the games
+         * @param actorCount number of games played at the same time
+         * @param learningRate
+         * @param discountRate
+         * @param nets the networks trained by the learner, must not be used by any other thread until the
+         * ActorLearner is destroyed
+         * @param seed seed of the first game, game i uses seed + i
+         * @param options
+         * @param targetNets target networks used by the learner, may be nullptr
+         * @param pool pool running the games, shared with other work. A pool with a thread per actor is created if
+         * nullptr, a given pool needs at least one thread besides the calling one.
+         */
+        ActorLearner(Actor actor, std::size_t actorCount, double learningRate, double discountRate,
+                     communication::Nets nets, std::uint64_t seed, LearnerOptions options,
+                     communication::TargetNets targetNets = {}, std::shared_ptr<ai::ThreadPool> pool = nullptr);
+
+        /**
+         * Destructor, stops the learner and waits until the running games finished
+         */
+        ~ActorLearner() override;
+
+        /**
+         * Waits for finished games
+         * @return all games finished since the last call
+         * @throws the exception of a failed game
+         */
+        auto collectGames() -> std::vector<communication::GameStatistics> override;
+        auto getPublishedNets() const -> std::shared_ptr<const communication::FrozenNets> override;
+        auto getStatistics() const -> LearnerStatistics override;
+
+    private:
+        Actor actor;
+        Learner learner;
+        std::uint64_t seed;
+        std::atomic<std::uint64_t> nextGame{0};
+        std::atomic<bool> stopping{false};
+
+        std::shared_ptr<ai::ThreadPool> pool;
+
+        std::mutex gamesMutex;
+        std::condition_variable gameFinished;
+        std::vector<communication::GameStatistics> finishedGames;
+        std::size_t runningActors = 0; ///< Actors which did not stop yet, guarded by gamesMutex
+        std::condition_variable actorStopped;
+        std::exception_ptr error; ///< Exception of the first failed game, guarded by gamesMutex
+
+        /**
+         * Plays one game of an actor and queues its next game on the pool, stops the actor instead when stopping
+         */
+        void act();
+
+        /**
+         * Stops the calling actor
+         * @param exception exception of the failed game, nullptr if the actor stops regularly
+         */
+        void stopActor(std::exception_ptr exception = nullptr);
+    };
+}
+
+#endif //KITRAINING_ACTORLEARNER_H
@@ -0,0 +1,34 @@
+#ifndef KITRAINING_ASYNCTRAINER_H
+#define KITRAINING_ASYNCTRAINER_H
+
+#include <vector>
+#include <Communication/Communicator.h>
+#include "Learner.h"
+
+namespace simulation {
+    /**
+     * Training that runs in the background with games played by actors and a learner training the networks
+     */
+    class AsyncTrainer {
+    public:
+        virtual ~AsyncTrainer() = default;
+
+        /**
+         * Blocks until at least one game finished since the last call
+         * @return the statistics of all games finished since the last call
+         */
+        virtual auto collectGames() -> std::vector<communication::GameStatistics> = 0;
+
+        /**
+         * @return the last published weights
+         */
+        virtual auto getPublishedNets() const -> std::shared_ptr<const communication::FrozenNets> = 0;
+
+        /**
+         * @return statistics of the actors and the learner so far
+         */
+        virtual auto getStatistics() const -> LearnerStatistics = 0;
+    };
+}
+
+#endif //KITRAINING_ASYNCTRAINER_H
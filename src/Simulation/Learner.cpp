@@ -0,0 +1,137 @@
+#include <array>
+#include <limits>
+#include <Profiling/Tracer.h>
+#include "Learner.h"
+
+namespace simulation {
+    Learner::Learner(double learningRate, double discountRate, communication::Nets nets, LearnerOptions options,
+                     communication::TargetNets targetNets) : learningRate(learningRate), discountRate(discountRate),
+                     nets(std::move(nets)), targetNets(std::move(targetNets)), options(options),
+                     queue(options.queueCapacity) {
+        if(options.batchSize == 0 || options.publishInterval == 0){
+            throw std::runtime_error("Batch size and publish interval have to be positive");
+        }
+
+        publish();
+        thread = std::thread{&Learner::learn, this};
+    }
+
+    Learner::~Learner() {
+        stopping = true;
+        {
+            // The learner checks stopping under this lock before it sleeps, taking it avoids a lost wake up
+            std::lock_guard<std::mutex> lock(wakeMutex);
+        }
+
+        transitionQueued.notify_one();
+        thread.join();
+    }
+
+    bool Learner::push(ai::Transition &&transition) {
+        if(queue.tryPush(std::move(transition))){
+            transitions++;
+            // Pairs with the fence in waitForTransition: either the learner sees the transition or this sees it sleeping
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(sleeping.load(std::memory_order_relaxed)){
+                {
+                    std::lock_guard<std::mutex> lock(wakeMutex);
+                }
+
+                transitionQueued.notify_one();
+            }
+
+            return true;
+        }
+
+        dropped++;
+        return false;
+    }
+
+    auto Learner::getPublishedNets() const -> std::shared_ptr<const communication::FrozenNets> {
+        return std::atomic_load(&publishedNets);
+    }
+
+    auto Learner::getStatistics() const -> LearnerStatistics {
+        return {transitions, dropped, batches, publications};
+    }
+
+    void Learner::learn() {
+        std::vector<ai::Transition> batch;
+        batch.reserve(options.batchSize);
+        std::size_t batchesSincePublish = 0;
+        while(!stopping){
+            while(batch.size() < options.batchSize){
+                auto transition = queue.tryPop();
+                if(!transition.has_value()){
+                    break;
+                }
+
+                batch.emplace_back(std::move(*transition));
+            }
+
+            if(batch.empty()){
+                waitForTransition();
+                continue;
+            }
+
+            KITRAINING_TRACE_SCOPE("Learner::learn");
+            if(nets.first == nets.second){
+                train(*nets.first, targetNets.first.get(), batch, true, true);
+            } else {
+                train(*nets.first, targetNets.first.get(), batch, true, false);
+                train(*nets.second, targetNets.second.get(), batch, false, true);
+            }
+
+            batches++;
+            batch.clear();
+            if(++batchesSincePublish >= options.publishInterval){
+                publish();
+                batchesSincePublish = 0;
+            }
+        }
+    }
+
+    void Learner::waitForTransition() {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        transitionQueued.wait(lock, [this]{ return stopping || !queue.empty(); });
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+
+    void Learner::train(ai::StateEstimator &net, ai::TargetNetwork *targetNet,
+                             const std::vector<ai::Transition> &batch, bool left, bool right) {
+        std::vector<ai::FeatureVec> features;
+        std::vector<std::array<double, 1>> targets;
+        for(const auto &transition : batch){
+            if(transition.side == gameModel::TeamSide::LEFT ? !left : !right){
+                continue;
+            }
+
+            auto bootstrap = targetNet ? targetNet->forward(transition.next) : net.forward(transition.next)[0];
+            features.emplace_back(transition.features);
+            targets.push_back({transition.reward + discountRate * bootstrap});
+        }
+
+        if(features.empty()){
+            return;
+        }
+
+        // The TD targets are passed as labels, the error is the TD error like in AI::train
+        auto tdErrorFun = [](const std::array<double, 1> &out, const std::array<double, 1> &target){
+            return target[0] - out[0];
+        };
+
+        net.train(features, targets, std::numeric_limits<double>::infinity(), tdErrorFun, learningRate);
+        if(targetNet){
+            targetNet->notifyUpdate();
+        }
+    }
+
+    void Learner::publish() {
+        std::shared_ptr<const ai::StateEstimator> left = std::make_shared<const ai::StateEstimator>(*nets.first);
+        auto right = nets.first == nets.second ? left : std::make_shared<const ai::StateEstimator>(*nets.second);
+        std::atomic_store(&publishedNets, std::make_shared<const communication::FrozenNets>(left, right));
+        publications++;
+    }
+}
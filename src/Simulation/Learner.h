@@ -0,0 +1,124 @@
+#ifndef KITRAINING_LEARNER_H
+#define KITRAINING_LEARNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Communication/Communicator.h>
+#include "MpscRingBuffer.h"
+
+namespace simulation {
+    /**
+     * Options of the learner
+     */
+    struct LearnerOptions {
+        std::size_t queueCapacity = 4096; ///< Maximum number of transitions waiting for the learner
+        std::size_t batchSize = 32; ///< Maximum number of transitions per training step
+        std::size_t publishInterval = 100; ///< Training steps between two publications of the weights
+    };
+
+    /**
+     * Work done by the actors and the learner
+     */
+    struct LearnerStatistics {
+        std::size_t transitions = 0; ///< Transitions pushed by the actors
+        std::size_t dropped = 0; ///< Transitions dropped because the queue was full
+        std::size_t batches = 0; ///< Training steps of the learner
+        std::size_t publications = 0; ///< Weight publications, including the initial one
+    };
+
+    /**
+     * Trains the networks on a dedicated thread with the transitions pushed by any number of actors. The transitions
+     * are queued in a lock-free ring buffer which the learner drains into mini-batch TD(0) updates, every
+     * publishInterval updates read only copies of the networks are published. Pushing to a full queue drops the
+     * transition and the learner trains on whatever is queued, so actors never wait for the learner. The learner sleeps
+     * while the queue is empty and is woken by the next push.
+     */
+    class Learner {
+    public:
+        /**
+         * Constructor, publishes the initial weights and starts the learner thread
+         * @param learningRate
+         * @param discountRate
+         * @param nets the trained networks, must not be used by any other thread until the Learner is destroyed
+         * @param options
+         * @param targetNets target networks used for the TD targets, may be nullptr
+         */
+        Learner(double learningRate, double discountRate, communication::Nets nets, LearnerOptions options,
+                communication::TargetNets targetNets = {});
+
+        /**
+         * Destructor, stops and joins the learner thread
+         */
+        ~Learner();
+
+        Learner(const Learner &) = delete;
+        auto operator=(const Learner &) -> Learner & = delete;
+
+        /**
+         * Queues a transition, may be called by any thread
+         * @param transition
+         * @return false if the queue was full and the transition was dropped
+         */
+        bool push(ai::Transition &&transition);
+
+        /**
+         * @return the last published weights, a new publication is a different pointer
+         */
+        auto getPublishedNets() const -> std::shared_ptr<const communication::FrozenNets>;
+
+        /**
+         * @return statistics of the pushed transitions and the learner so far
+         */
+        auto getStatistics() const -> LearnerStatistics;
+
+    private:
+        double learningRate;
+        double discountRate;
+        communication::Nets nets;
+        communication::TargetNets targetNets;
+        LearnerOptions options;
+
+        MpscRingBuffer<ai::Transition> queue;
+        std::shared_ptr<const communication::FrozenNets> publishedNets; ///< Only accessed with std::atomic_load and std::atomic_store
+        std::atomic<bool> stopping{false};
+        std::atomic<std::size_t> transitions{0};
+        std::atomic<std::size_t> dropped{0};
+        std::atomic<std::size_t> batches{0};
+        std::atomic<std::size_t> publications{0};
+        std::atomic<bool> sleeping{false}; ///< Whether the learner waits for a transition, pushes only lock if it does
+        std::mutex wakeMutex;
+        std::condition_variable transitionQueued;
+        std::thread thread;
+
+        /**
+         * Main loop of the learner thread
+         */
+        void learn();
+
+        /**
+         * Blocks the learner thread until a transition is queued or the learner stops
+         */
+        void waitForTransition();
+
+        /**
+         * Trains one network with the transitions of the given sides
+         * @param net
+         * @param targetNet may be nullptr
+         * @param batch
+         * @param left train the transitions of the left team
+         * @param right train the transitions of the right team
+         */
+        void train(ai::StateEstimator &net, ai::TargetNetwork *targetNet, const std::vector<ai::Transition> &batch,
+                   bool left, bool right);
+
+        /**
+         * Copies the current weights for the actors
+         */
+        void publish();
+    };
+}
+
+#endif //KITRAINING_LEARNER_H
@@ -0,0 +1,132 @@
+#ifndef KITRAINING_MPSCRINGBUFFER_H
+#define KITRAINING_MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+namespace simulation {
+    /**
+     * Bounded lock-free queue for many producers and a single consumer. Every cell carries a sequence number that
+     * tells producers and the consumer whether the cell is free or filled for the current lap, so neither side ever
+     * blocks: pushing to a full buffer and popping from an empty buffer fail immediately.
+     * @tparam T element type, has to be default constructible and move assignable
+     */
+    template<typename T>
+    class MpscRingBuffer {
+    public:
+        /**
+         * Constructor
+         * @param capacity maximum number of elements, rounded up to a power of two
+         */
+        explicit MpscRingBuffer(std::size_t capacity);
+
+        MpscRingBuffer(const MpscRingBuffer &) = delete;
+        auto operator=(const MpscRingBuffer &) -> MpscRingBuffer & = delete;
+
+        /**
+         * Appends an element, may be called by any thread
+         * @param value
+         * @return false if the buffer is full, value is not consumed in that case
+         */
+        bool tryPush(T &&value);
+
+        /**
+         * Removes the oldest element, may only be called by one thread at a time
+         * @return the element, nullopt if the buffer is empty
+         */
+        auto tryPop() -> std::optional<T>;
+
+        /**
+         * Checks whether the oldest element is ready to be popped, may only be called by the consuming thread
+         * @return true if tryPop would return nullopt
+         */
+        auto empty() const -> bool;
+
+        /**
+         * @return maximum number of elements
+         */
+        auto capacity() const -> std::size_t;
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t mask;
+        alignas(64) std::atomic<std::size_t> tail{0}; ///< Next position to push, shared by all producers
+        alignas(64) std::size_t head = 0; ///< Next position to pop, only used by the consumer
+    };
+
+    template<typename T>
+    MpscRingBuffer<T>::MpscRingBuffer(std::size_t capacity) {
+        if(capacity == 0){
+            throw std::runtime_error("Capacity has to be at least 1");
+        }
+
+        std::size_t size = 1;
+        while(size < capacity){
+            size <<= 1U;
+        }
+
+        cells = std::make_unique<Cell[]>(size);
+        mask = size - 1;
+        for(std::size_t i = 0; i < size; i++){
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T>
+    bool MpscRingBuffer<T>::tryPush(T &&value) {
+        auto position = tail.load(std::memory_order_relaxed);
+        Cell *cell;
+        while(true){
+            cell = &cells[position & mask];
+            auto sequence = cell->sequence.load(std::memory_order_acquire);
+            auto lap = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if(lap == 0){
+                if(tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                    break;
+                }
+            } else if(lap < 0){
+                // The consumer has not popped this cell from the previous lap yet
+                return false;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T>
+    auto MpscRingBuffer<T>::tryPop() -> std::optional<T> {
+        auto &cell = cells[head & mask];
+        if(cell.sequence.load(std::memory_order_acquire) != head + 1){
+            return std::nullopt;
+        }
+
+        std::optional<T> value{std::move(cell.value)};
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        head++;
+        return value;
+    }
+
+    template<typename T>
+    auto MpscRingBuffer<T>::empty() const -> bool {
+        return cells[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+
+    template<typename T>
+    auto MpscRingBuffer<T>::capacity() const -> std::size_t {
+        return mask + 1;
+    }
+}
+
+#endif //KITRAINING_MPSCRINGBUFFER_H
@@ -0,0 +1,35 @@
+#include <cstdlib>
+#include <iostream>
+#include "Options.h"
+
+namespace cli {
+    auto extractOptions(int &argc, char *argv[], const std::set<std::string> &known, UsageFun usage) -> Options {
+        Options options;
+        int positional = 1;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg{argv[i]};
+            auto separator = arg.find('=');
+            if (arg.rfind("--", 0) == 0) {
+                auto name = arg.substr(2, separator == std::string::npos ? std::string::npos : separator - 2);
+                if(known.count(name) == 0 || separator == std::string::npos){
+                    std::cerr << "Unknown option " << arg << ", options have the form --name=value" << std::endl;
+                    usage();
+                    std::exit(1);
+                }
+
+                options.emplace(name, arg.substr(separator + 1));
+            } else {
+                argv[positional++] = argv[i];
+            }
+        }
+
+        argc = positional;
+        return options;
+    }
+
+    void invalidValue(const std::string &name, const std::string &value, UsageFun usage) {
+        std::cerr << "Invalid value \"" << value << "\" of " << name << std::endl;
+        usage();
+        std::exit(1);
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef KITRAINING_OPTIONS_H
+#define KITRAINING_OPTIONS_H
+
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace cli {
+    using Options = std::map<std::string, std::string>;
+
+    /**
+     * Prints the usage of the program
+     */
+    using UsageFun = void (*)();
+
+    /**
+     * Removes all named options of the form --name=value from the argument list. Prints the usage and exits if an
+     * option is not known.
+     * @param argc number of arguments, is decreased by the number of removed options
+     * @param argv argument list, the remaining positional arguments are moved to the front
+     * @param known names of all options of the program
+     * @param usage
+     * @return map from option name to value
+     */
+    auto extractOptions(int &argc, char *argv[], const std::set<std::string> &known, UsageFun usage) -> Options;
+
+    /**
+     * Prints that an argument has an invalid value followed by the usage and exits
+     * @param name
+     * @param value
+     * @param usage
+     */
+    [[noreturn]] void invalidValue(const std::string &name, const std::string &value, UsageFun usage);
+
+    /**
+     * Parses a number, prints the usage and exits if the value is no number of type T
+     * @tparam T arithmetic type of the number, negative values are rejected for unsigned types
+     * @param name name of the argument, used in the error message
+     * @param value
+     * @param usage
+     * @return
+     */
+    template<typename T>
+    auto parseNumber(const std::string &name, const std::string &value, UsageFun usage) -> T;
+
+    /**
+     * Parses the value of a numeric option, prints the usage and exits if the value is no number of type T
+     * @tparam T arithmetic type of the number
+     * @param options
+     * @param name
+     * @param defaultValue returned if the option is not given
+     * @param usage
+     * @return
+     */
+    template<typename T>
+    auto numberOption(const Options &options, const std::string &name, T defaultValue, UsageFun usage) -> T;
+
+    template<typename T>
+    auto parseNumber(const std::string &name, const std::string &value, UsageFun usage) -> T {
+        static_assert(std::is_arithmetic_v<T>, "Only numbers can be parsed");
+        std::size_t parsed = 0;
+        T result{};
+        try {
+            if constexpr (std::is_floating_point_v<T>) {
+                result = static_cast<T>(std::stod(value, &parsed));
+            } else if constexpr (std::is_unsigned_v<T>) {
+                // std::stoull wraps negative numbers around
+                auto number = std::stoull(value, &parsed);
+                if(value.find('-') != std::string::npos || number > std::numeric_limits<T>::max()){
+                    invalidValue(name, value, usage);
+                }
+
+                result = static_cast<T>(number);
+            } else {
+                auto number = std::stoll(value, &parsed);
+                if(number < std::numeric_limits<T>::min() || number > std::numeric_limits<T>::max()){
+                    invalidValue(name, value, usage);
+                }
+
+                result = static_cast<T>(number);
+            }
+        } catch (std::logic_error &) {
+            // std::invalid_argument or std::out_of_range
+            invalidValue(name, value, usage);
+        }
+
+        if(parsed != value.size()){
+            invalidValue(name, value, usage);
+        }
+
+        return result;
+    }
+
+    template<typename T>
+    auto numberOption(const Options &options, const std::string &name, T defaultValue, UsageFun usage) -> T {
+        auto option = options.find(name);
+        return option == options.end() ? defaultValue : parseNumber<T>("--" + name, option->second, usage);
+    }
+}
+
+#endif //KITRAINING_OPTIONS_H
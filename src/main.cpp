@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <filesystem>
 #include <fstream>
@@ -6,7 +9,15 @@
 #include <SopraMessages/MatchConfig.hpp>
 #include <SopraUtil/Logging.hpp>
 #include <Communication/Communicator.h>
-#include <Mlp/Util.h>
+#include <Simulation/ActorLearner.h>
+#include <Distributed/ActorClient.h>
+#include <Distributed/LearnerServer.h>
+#include <AI/NetFile.h>
+#include <Profiling/PhaseTimer.h>
+#include <Profiling/Tracer.h>
+#include <Metrics/MetricsWriter.h>
+#include <League/OpponentPool.h>
+#include <Util/Options.h>
 
 template <typename T>
 auto readFromFileToJson(const std::string &fname) -> T {
@@ -32,6 +43,10 @@ auto readFromFileToJson(const std::string &fname) -> T {
     return t;
 }
 
+void printUsage() {
+    std::cerr << "Usage: KiTraining matchConfig.json leftTeamConfig.json rightTeamConfig.json learningRate discountRate [pretrainedNet] [experienceDirectory experienceReplayEpochCount] [--seed=<seed>] [--search=<aitools|make-unmake>] [--threads=<threadCount>] [--profile=<epochInterval>] [--metrics=<file.jsonl>] [--trace=<epochInterval>] [--allocations=<epochInterval>] [--td=<td0|n-step|lambda>] [--n-step=<n>] [--lambda=<lambda>] [--target-sync=<updateInterval>] [--network=<separate|shared>] [--augment=<none|mirror>] [--league=<snapshotCount>] [--league-interval=<epochInterval>] [--league-self-play=<weight>] [--league-decay=<decay>] [--actors=<threadCount>] [--batch-size=<n>] [--publish-interval=<batches>] [--queue-capacity=<transitions>] [--serve=<address>] [--connect=<address>]" << std::endl;
+}
+
 // stolen from https://stackoverflow.com/questions/5043403/listing-only-folders-in-directory
 std::vector<std::string> get_directories(const std::string& s){
     std::vector<std::string> r;
@@ -46,32 +61,144 @@ std::vector<std::string> get_directories(const std::string& s){
 
 int main(int argc, char *argv[]) {
     using namespace communication;
+    auto options = cli::extractOptions(argc, argv, {"seed", "search", "threads", "profile", "metrics", "trace",
+            "allocations", "td", "n-step", "lambda", "target-sync", "network", "augment", "league", "league-interval",
+            "league-self-play", "league-decay", "actors", "batch-size", "publish-interval", "queue-capacity", "serve",
+            "connect"}, printUsage);
     if (argc != 6 && argc != 7 && argc != 8 && argc != 9) {
-        std::cerr << "Usage: KiTraining matchConfig.json leftTeamConfig.json rightTeamConfig.json learningRate discountRate [pretrainedNet] [experienceDirectory experienceReplayEpochCount]" << std::endl;
+        printUsage();
         std::exit(1);
     }
 
     std::string matchConfigPath{argv[1]};
     std::string leftTeamConfiPath{argv[2]};
     std::string rightTeamConfigPath{argv[3]};
-    auto learningRate = std::stod(argv[4]);
-    auto discountRate = std::stod(argv[5]);
+    auto learningRate = cli::parseNumber<double>("learningRate", argv[4], printUsage);
+    auto discountRate = cli::parseNumber<double>("discountRate", argv[5], printUsage);
     std::optional<std::vector<std::string>> expDirList;
     std::optional<int> expEpochs;
     std::optional<std::filesystem::directory_iterator> expDirIt;
     std::optional<std::string> pretrainedNet;
     bool expReplayEnabled = false;
     std::vector<std::string>::iterator dirListIt;
+    auto seed = cli::numberOption<std::uint64_t>(options, "seed", gameHandling::Rng::randomSeed(), printUsage);
+    ai::SearchOptions searchOptions;
+    if(options.count("search") && options.at("search") != "aitools" && options.at("search") != "make-unmake"){
+        cli::invalidValue("--search", options.at("search"), printUsage);
+    }
+
+    searchOptions.makeUnmake = options.count("search") && options.at("search") == "make-unmake";
+    searchOptions.threads = cli::numberOption<std::size_t>(options, "threads", 1, printUsage);
+    if(searchOptions.threads == 0){
+        std::cerr << "Thread count has to be at least 1" << std::endl;
+        std::exit(1);
+    }
+
+    ai::TrainingOptions trainingOptions;
+    if(options.count("td")){
+        const auto &mode = options.at("td");
+        if(mode == "n-step"){
+            trainingOptions.tdMode = ai::TdMode::NStep;
+        } else if(mode == "lambda"){
+            trainingOptions.tdMode = ai::TdMode::Lambda;
+        } else if(mode != "td0"){
+            std::cerr << "Unknown TD mode " << mode << std::endl;
+            std::exit(1);
+        }
+    }
+
+    trainingOptions.nStep = cli::numberOption(options, "n-step", trainingOptions.nStep, printUsage);
+    trainingOptions.lambda = cli::numberOption(options, "lambda", trainingOptions.lambda, printUsage);
+    if(trainingOptions.nStep == 0 || trainingOptions.lambda < 0 || trainingOptions.lambda > 1){
+        std::cerr << "n-step has to be at least 1 and lambda in [0, 1]" << std::endl;
+        std::exit(1);
+    }
+
+    if(options.count("network")){
+        const auto &network = options.at("network");
+        if(network != "separate" && network != "shared"){
+            std::cerr << "Unknown network mode " << network << std::endl;
+            std::exit(1);
+        }
+
+        trainingOptions.sharedNetwork = network == "shared";
+    }
+
+    if(options.count("augment")){
+        const auto &augment = options.at("augment");
+        if(augment != "none" && augment != "mirror"){
+            std::cerr << "Unknown augmentation " << augment << std::endl;
+            std::exit(1);
+        }
+
+        trainingOptions.mirrorAugmentation = augment == "mirror";
+        if(trainingOptions.mirrorAugmentation && trainingOptions.sharedNetwork){
+            std::cerr << "--augment=mirror requires --network=separate" << std::endl;
+            std::exit(1);
+        }
+    }
+
+    std::optional<league::OpponentPool> opponentPool;
+    if(options.count("league")){
+        league::LeagueOptions leagueOptions;
+        leagueOptions.capacity = cli::numberOption(options, "league", leagueOptions.capacity, printUsage);
+        leagueOptions.snapshotInterval = cli::numberOption(options, "league-interval", leagueOptions.snapshotInterval,
+                printUsage);
+        leagueOptions.selfPlayWeight = cli::numberOption(options, "league-self-play", leagueOptions.selfPlayWeight,
+                printUsage);
+        leagueOptions.decay = cli::numberOption(options, "league-decay", leagueOptions.decay, printUsage);
+        try {
+            opponentPool.emplace(leagueOptions);
+        } catch (std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            std::exit(1);
+        }
+    }
+
+    std::optional<simulation::LearnerOptions> learnerOptions;
+    auto actorCount = cli::numberOption<std::size_t>(options, "actors", 1, printUsage);
+    if(actorCount == 0 || (options.count("serve") && options.count("connect"))){
+        std::cerr << "At least one actor is needed and --serve can not be combined with --connect" << std::endl;
+        std::exit(1);
+    }
+
+    if(options.count("actors") || options.count("serve")){
+        simulation::LearnerOptions asyncOptions;
+        asyncOptions.batchSize = cli::numberOption(options, "batch-size", asyncOptions.batchSize, printUsage);
+        asyncOptions.publishInterval = cli::numberOption(options, "publish-interval", asyncOptions.publishInterval,
+                printUsage);
+        asyncOptions.queueCapacity = cli::numberOption(options, "queue-capacity", asyncOptions.queueCapacity,
+                printUsage);
+        if(argc >= 8 || opponentPool.has_value() || trainingOptions.tdMode != ai::TdMode::TD0 ||
+            trainingOptions.mirrorAugmentation){
+            std::cerr << "--actors and --serve can not be combined with experience replay, --league, --augment=mirror "
+                         "or n-step and lambda returns" << std::endl;
+            std::exit(1);
+        }
+
+        learnerOptions = asyncOptions;
+    }
+
+    // One work-stealing pool rates the candidates of both AIs, loads experience and saves checkpoints. With local
+    // actors it also runs their games, every actor gets a thread of its own.
+    auto poolSize = learnerOptions.has_value() && !options.count("serve") ?
+            std::max(searchOptions.threads, actorCount + 1) : searchOptions.threads;
+    auto pool = std::make_shared<ai::ThreadPool>(poolSize);
+    searchOptions.pool = pool;
+
+    auto profileInterval = cli::numberOption(options, "profile", 0, printUsage);
+    auto traceInterval = cli::numberOption(options, "trace", 0, printUsage);
+    auto allocationInterval = cli::numberOption(options, "allocations", 0, printUsage);
 
     if(argc == 7) {
         pretrainedNet.emplace(argv[6]);
     } else if(argc == 8) {
         expDirList.emplace(get_directories(argv[6]));
-        expEpochs.emplace(std::stoi(argv[7]));
+        expEpochs.emplace(cli::parseNumber<int>("experienceReplayEpochCount", argv[7], printUsage));
     } else if(argc == 9) {
         pretrainedNet.emplace(argv[6]);
         expDirList.emplace(get_directories(argv[7]));
-        expEpochs.emplace(std::stoi(argv[8]));
+        expEpochs.emplace(cli::parseNumber<int>("experienceReplayEpochCount", argv[8], printUsage));
     }
 
     auto matchConfig = readFromFileToJson<messages::broadcast::MatchConfig>(matchConfigPath);
@@ -79,19 +206,83 @@ int main(int argc, char *argv[]) {
     auto rightTeamConfig = readFromFileToJson<messages::request::TeamConfig>(rightTeamConfigPath);
 
     util::Logging log{std::cout, 4};
+    log.info("Seed: " + std::to_string(seed));
+    if(profileInterval > 0 && !profiling::enabled()){
+        log.warn("Built without KITRAINING_PROFILING, --profile has no effect");
+    }
+
+    if(allocationInterval > 0 && !profiling::allocationTrackingEnabled()){
+        log.warn("Built without KITRAINING_ALLOCATION_TRACKING, --allocations has no effect");
+    }
+
+    std::optional<metrics::MetricsWriter> metricsWriter;
+    if(options.count("metrics")){
+        metricsWriter.emplace(options.at("metrics"));
+    }
 
-    std::unique_ptr<std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-            ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>>> mlps;
+    Nets mlps;
 
-    if(pretrainedNet.has_value()){
+    if(trainingOptions.sharedNetwork){
+        log.info("--- training one mirrored net for both teams ---");
+        auto net = pretrainedNet.has_value() ?
+                std::make_shared<ai::StateEstimator>(ai::loadNet(*pretrainedNet)) :
+                std::make_shared<ai::StateEstimator>(ml::functions::relu, ml::functions::relu, ml::functions::identity);
+        mlps = std::make_pair(net, net);
+    } else if(pretrainedNet.has_value()){
         log.info("--- training with pretrained net ---");
-        mlps = std::make_unique<decltype(mlps)::element_type>(std::make_pair(ml::util::loadFromFile<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>(*pretrainedNet),
-                    ml::util::loadFromFile<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>(*pretrainedNet)));
+        mlps = std::make_pair(std::make_shared<ai::StateEstimator>(ai::loadNet(*pretrainedNet)),
+                std::make_shared<ai::StateEstimator>(ai::loadNet(*pretrainedNet)));
     } else {
-        mlps = std::make_unique<std::pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-            ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>>>(std::make_pair<ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>,
-            ml::Mlp<aiTools::State::FEATURE_VEC_LEN, 200, 200, 1>>({ml::functions::relu, ml::functions::relu, ml::functions::identity},
-                                                                   {ml::functions::relu, ml::functions::relu, ml::functions::identity}));
+        mlps = std::make_pair(std::make_shared<ai::StateEstimator>(ml::functions::relu, ml::functions::relu, ml::functions::identity),
+                std::make_shared<ai::StateEstimator>(ml::functions::relu, ml::functions::relu, ml::functions::identity));
+    }
+
+    TargetNets targetNets;
+    if(options.count("target-sync")){
+        auto syncInterval = cli::numberOption<std::size_t>(options, "target-sync", 0, printUsage);
+        if(syncInterval == 0){
+            std::cerr << "The target sync interval has to be a positive number of updates" << std::endl;
+            printUsage();
+            std::exit(1);
+        }
+
+        auto leftTarget = std::make_shared<ai::TargetNetwork>(mlps.first, syncInterval);
+        targetNets = std::make_pair(leftTarget, trainingOptions.sharedNetwork ? leftTarget :
+                std::make_shared<ai::TargetNetwork>(mlps.second, syncInterval));
+        log.info("Target networks are synchronised every " + std::to_string(syncInterval) + " updates");
+    }
+
+    if(options.count("connect")){
+        // Actor process, plays games for the learner process until the connection fails
+        simulation::Actor actor{matchConfig, leftTeamConfig, rightTeamConfig, trainingOptions.sharedNetwork};
+        log.info("--- " + std::to_string(actorCount) + " actors connecting to " + options.at("connect") + " ---");
+        try {
+            distributed::runActors(options.at("connect"), actorCount, seed, actor);
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            std::exit(1);
+        }
+
+        return 0;
+    }
+
+    std::unique_ptr<simulation::AsyncTrainer> asyncTrainer;
+    if(learnerOptions.has_value()){
+        try {
+            if(options.count("serve")){
+                asyncTrainer = std::make_unique<distributed::LearnerServer>(options.at("serve"), learningRate,
+                        discountRate, mlps, *learnerOptions, targetNets);
+                log.info("--- Learner waiting for actors on " + options.at("serve") + " ---");
+            } else {
+                asyncTrainer = std::make_unique<simulation::ActorLearner>(
+                        simulation::Actor{matchConfig, leftTeamConfig, rightTeamConfig, trainingOptions.sharedNetwork},
+                        actorCount, learningRate, discountRate, mlps, seed, *learnerOptions, targetNets, pool);
+                log.info("--- " + std::to_string(actorCount) + " actors and one learner ---");
+            }
+        } catch (std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            std::exit(1);
+        }
     }
 
     if(argc < 8){
@@ -108,9 +299,37 @@ int main(int argc, char *argv[]) {
     }
 
 
+    std::optional<std::future<aiTools::State>> nextExperience; ///< Loaded while the previous epochs are played
+    std::optional<std::future<void>> checkpointSaved;
+    gameHandling::Rng leagueRng{seed};
     for (auto epoch = 0; epoch < std::numeric_limits<int>::max(); ++epoch) {
         std::unique_ptr<Communicator> communicator;
-        if(expReplayEnabled && epoch % *expEpochs == 0){
+        std::vector<GameStatistics> games;
+        FrozenNets frozenNets;
+        if(opponentPool.has_value()){
+            if(epoch % opponentPool->getOptions().snapshotInterval == 0){
+                opponentPool->add(mlps, epoch);
+                log.warn("League snapshot of epoch " + std::to_string(epoch) + " added, " +
+                    std::to_string(opponentPool->size()) + " opponents");
+            }
+
+            auto opponent = opponentPool->sample(leagueRng);
+            if(opponent.has_value()){
+                // The learning networks alternate between both teams
+                auto opponentSide = epoch % 2 == 0 ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
+                frozenNets = opponent->playing(opponentSide);
+                log.info("Playing against the snapshot of epoch " + std::to_string(opponent->epoch));
+            }
+        }
+
+        auto epochStart = std::chrono::steady_clock::now();
+        bool traced = traceInterval > 0 && epoch % traceInterval == 0;
+        profiling::Tracer::setRecording(traced);
+        profiling::resetAllocations();
+        if(asyncTrainer){
+            // An epoch collects all games the actors finished since the last epoch
+            games = asyncTrainer->collectGames();
+        } else if(expReplayEnabled && epoch % *expEpochs == 0){
             if(*expDirIt == std::filesystem::end(*expDirIt)) {
                 if(++dirListIt == expDirList->end()){
                     log.warn("--- No experience left, resetting ---");
@@ -122,24 +341,97 @@ int main(int argc, char *argv[]) {
             }
 
             log.warn("--- Experience replay epoch ---");
-            auto state = readFromFileToJson<aiTools::State>(expDirIt.value()->path().string());
-            communicator = std::make_unique<Communicator>(matchConfig, state, log, learningRate, discountRate, *mlps, "---");
-            ++(*expDirIt);
+            auto loadExperience = [](std::string path){
+                KITRAINING_TRACE_SCOPE("load experience");
+                return readFromFileToJson<aiTools::State>(path);
+            };
+
+            auto state = nextExperience.has_value() ? nextExperience->get() :
+                    loadExperience(expDirIt.value()->path().string());
+            nextExperience.reset();
+            if(++(*expDirIt) != std::filesystem::end(*expDirIt)){
+                nextExperience = pool->submit([loadExperience, path = expDirIt.value()->path().string()]{
+                    return loadExperience(path);
+                });
+            }
+
+            communicator = std::make_unique<Communicator>(matchConfig, state, log, learningRate, discountRate, mlps, "---",
+                    seed + epoch, searchOptions, trainingOptions, targetNets, frozenNets);
+            games.emplace_back(communicator->getStatistics());
 
         } else {
             communicator = std::make_unique<Communicator>(matchConfig, leftTeamConfig, rightTeamConfig, log, learningRate,
-                                                 discountRate, *mlps, "---");
+                                                 discountRate, mlps, "---", seed + epoch, searchOptions, trainingOptions, targetNets,
+                                                 frozenNets);
+            games.emplace_back(communicator->getStatistics());
+        }
+
+        if(metricsWriter.has_value()){
+            auto epochSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - epochStart).count();
+            for(std::size_t i = 0; i < games.size(); i++){
+                metricsWriter->write({epoch, i, games[i], epochSeconds, games.size() / epochSeconds});
+            }
         }
 
-        mlps = std::make_unique<decltype(communicator->mlps)>(communicator->mlps);
         log.warn("Epoch finished: " + std::to_string(epoch));
 
+        if(profiling::enabled() && profileInterval > 0 && (epoch + 1) % profileInterval == 0){
+            log.warn("Phase timings of the last " + std::to_string(profileInterval) + " epochs:\n" +
+                profiling::toString(profiling::collect()));
+            profiling::reset();
+        }
+
+        if(profiling::allocationTrackingEnabled() && allocationInterval > 0 && epoch % allocationInterval == 0){
+            log.warn("Allocations of epoch " + std::to_string(epoch) + ":\n" +
+                profiling::toString(profiling::collectAllocations()));
+        }
+
         if (epoch % 10000 == 0) {
-            ml::util::saveToFile(std::string{"trainingFiles/left_epoch"} + std::to_string(epoch) + std::string{".json"},
-                                 mlps->first);
-            ml::util::saveToFile(
-                    std::string{"trainingFiles/right_epoch"} + std::to_string(epoch) + std::string{".json"},
-                    mlps->second);
+            // The learner thread trains mlps, its last published weights are saved instead. Otherwise mlps are
+            // copied, the copies are written while the next epochs train mlps.
+            FrozenNets saved;
+            if(asyncTrainer){
+                saved = *asyncTrainer->getPublishedNets();
+            } else {
+                saved.first = std::make_shared<const ai::StateEstimator>(*mlps.first);
+                saved.second = mlps.first == mlps.second ? saved.first : std::make_shared<const ai::StateEstimator>(*mlps.second);
+            }
+
+            if(checkpointSaved.has_value()){
+                checkpointSaved->get();
+            }
+
+            checkpointSaved = pool->submit([saved, epoch, shared = trainingOptions.sharedNetwork]{
+                KITRAINING_TRACE_SCOPE("save checkpoint");
+                if(shared){
+                    ai::saveNet(std::string{"trainingFiles/shared_epoch"} + std::to_string(epoch) + std::string{".json"},
+                                         *saved.first);
+                } else {
+                    ai::saveNet(std::string{"trainingFiles/left_epoch"} + std::to_string(epoch) + std::string{".json"},
+                                         *saved.first);
+                    ai::saveNet(
+                            std::string{"trainingFiles/right_epoch"} + std::to_string(epoch) + std::string{".json"},
+                            *saved.second);
+                }
+            });
+
+            if(asyncTrainer){
+                auto statistics = asyncTrainer->getStatistics();
+                log.warn("Transitions: " + std::to_string(statistics.transitions) + ", dropped: " +
+                    std::to_string(statistics.dropped) + ", batches: " + std::to_string(statistics.batches) +
+                    ", publications: " + std::to_string(statistics.publications));
+            }
+
+            if(metricsWriter.has_value()){
+                metricsWriter->flush();
+            }
+        }
+
+        if(traced){
+            profiling::Tracer::setRecording(false);
+            auto traceFile = "trace_epoch" + std::to_string(epoch) + ".json";
+            profiling::Tracer::write(traceFile);
+            log.warn("Trace written to " + traceFile);
         }
     }
 